@@ -1,24 +1,31 @@
 #pragma once
 
+#include "NeuralNetwork/Math/Policy.h"
+
 #include <cmath>
+#include <cstddef>
 #include <functional>
 #include <numeric>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace nn {
 
-    template< typename VarType >
+    template< typename VarType, typename MathPolicy = math::Exact >
     struct BiopolarSigmoidFunction {
         typedef VarType Var;
 
         template< typename V >
-        using use = BiopolarSigmoidFunction< V >;
+        using use = BiopolarSigmoidFunction< V, MathPolicy >;
 
         template< typename Iterator >
         Var calculate(const Var& sum, Iterator begin, Iterator end) const {
-            Var tmp = sum * Var{-2.0f};
-            return Var{2.0f} / (Var{1.f} + std::exp(tmp)) - Var{1.0f};
+            return Policy::tanh(sum);
+        }
+
+        void apply(std::span< const Var > in, std::span< Var > out) const {
+            Policy::tanh(in.data(), out.data(), in.size());
         }
 
         Var delta(const Var& output, const Var& expectedOutput) const {
@@ -33,5 +40,14 @@ namespace nn {
         Var derivate(const Var& output) const {
             return (Var{1.0f} - output * output) / Var{2.0f};
         }
+
+      private:
+        using Policy = math::select_policy_t< MathPolicy, Var >;
     };
+
+    template< typename VarType >
+    using FastBiopolarSigmoidFunction = BiopolarSigmoidFunction< VarType, math::Polynomial >;
+
+    template< typename VarType >
+    using LutBiopolarSigmoidFunction = BiopolarSigmoidFunction< VarType, math::LookupTable<> >;
 } // namespace nn
@@ -3,6 +3,7 @@
 #include <functional>
 #include <numeric>
 #include <cmath>
+#include <span>
 #include <utility>
 #include <algorithm>
 #include <boost/iterator/transform_iterator.hpp>
@@ -27,6 +28,13 @@ namespace nn {
             return sum / sum2;
         }
 
+        void apply(std::span< const Var > in, std::span< Var > out) const {
+            const Var total = std::accumulate(in.begin(), in.end(), Var{});
+            for(std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = in[i] / total;
+            }
+        }
+
         template< typename Iterator >
         Var sum(Iterator begin, Iterator end, const Var& start) const {
             Var max = *begin;
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <numeric>
+#include <span>
 
 namespace nn {
 
@@ -22,6 +24,12 @@ namespace nn {
             return sum >= 0 ? sum : 0;
         }
 
+        void apply(std::span< const Var > in, std::span< Var > out) const {
+            for(std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = in[i] >= 0 ? in[i] : Var{};
+            }
+        }
+
         template< typename Iterator >
         Var sum(Iterator begin, Iterator end, const Var& start) const {
             return std::accumulate(begin, end, start);
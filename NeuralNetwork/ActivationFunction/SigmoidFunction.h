@@ -1,19 +1,24 @@
 #pragma once
 
+#include "NeuralNetwork/Math/Policy.h"
+
 #include <numeric>
 #include <cmath>
+#include <cstddef>
+#include <span>
 
 namespace nn {
 
     /**
      * Sigmoid function implementation.
      * Used by not-linear neural networks.
+     * @tparam MathPolicy evaluates the sigmoid, see NeuralNetwork/Math/Policy.h.
      */
-    template< class VarType >
+    template< class VarType, typename MathPolicy = math::Exact >
     struct SigmoidFunction {
         typedef VarType Var;
         template< typename V >
-        using use = SigmoidFunction< V >;
+        using use = SigmoidFunction< V, MathPolicy >;
 
         /**
          * Will calculate the equation
@@ -25,6 +30,18 @@ namespace nn {
             return calculate(sum);
         }
 
+        /**
+         * Will calculate the equation for all dot products of a layer.
+         * @param in the dot products.
+         * @param out the outputs, may be the same memory as in.
+         */
+        void apply(std::span< const Var > in, std::span< Var > out) const {
+            for(std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = m_slope * in[i];
+            }
+            Policy::sigmoid(out.data(), out.data(), out.size());
+        }
+
         template< typename Iterator >
         Var sum(Iterator begin, Iterator end, const Var& start) const {
             return std::accumulate(begin, end, start);
@@ -45,8 +62,12 @@ namespace nn {
         }
 
       private:
+        /// @brief MathPolicy, unless Var brings its own approximations
+        /// (math::select_policy).
+        using Policy = math::select_policy_t< MathPolicy, Var >;
+
         Var calculate(const Var& sum) const {
-            return Var{1.f} / (Var{1.f} + std::exp(-(m_slope * sum)));
+            return Policy::sigmoid(m_slope * sum);
         }
 
         /**
@@ -54,4 +75,12 @@ namespace nn {
          */
         Var m_slope{1.f};
     };
+
+    /// @brief sigmoid evaluated by a rational polynomial.
+    template< class VarType >
+    using FastSigmoidFunction = SigmoidFunction< VarType, math::Polynomial >;
+
+    /// @brief sigmoid evaluated by an interpolated lookup table.
+    template< class VarType >
+    using LutSigmoidFunction = SigmoidFunction< VarType, math::LookupTable<> >;
 } // namespace nn
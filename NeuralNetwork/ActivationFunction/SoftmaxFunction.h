@@ -1,10 +1,14 @@
 #pragma once
 
+#include "NeuralNetwork/Math/Exp.h"
+
 #include <functional>
 #include <numeric>
 #include <utility>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <span>
 
 namespace nn {
 
@@ -14,14 +18,43 @@ namespace nn {
         template< typename V >
         using use = SoftmaxFunction< V >;
 
+        /**
+         * Will calculate the output of one neuron, the maximum of the dot
+         * products is subtracted before exp so large values do not overflow.
+         * Use apply to calculate the outputs of the whole layer at once.
+         */
         template< typename Iterator >
         Var calculate(const Var& sum, Iterator begin, Iterator end) const {
-            return std::exp(sum) /
-                   std::accumulate(begin, end, Var{}, [](Var init, Var next) -> Var {
-                       return init + std::exp(next);
+            if(begin == end) {
+                return Var{1.f};
+            }
+            using std::exp;
+            const Var max = *std::max_element(begin, end);
+            return exp(sum - max) /
+                   std::accumulate(begin, end, Var{}, [max](Var init, Var next) -> Var {
+                       return init + exp(next - max);
                    });
         }
 
+        /**
+         * Will calculate the outputs of the whole layer, the maximum, the
+         * exponentials and their sum are calculated once per layer.
+         */
+        void apply(std::span< const Var > in, std::span< Var > out) const {
+            if(in.empty()) {
+                return;
+            }
+            const Var max = *std::max_element(in.begin(), in.end());
+            for(std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = in[i] - max;
+            }
+            math::exp(out.data(), out.data(), out.size());
+            const Var total = std::accumulate(out.begin(), out.end(), Var{});
+            for(auto& value : out) {
+                value /= total;
+            }
+        }
+
         template< typename Iterator >
         Var sum(Iterator begin, Iterator end, const Var& start) const {
             return std::accumulate(begin, end, start);
@@ -1,23 +1,31 @@
 #pragma once
 
+#include "NeuralNetwork/Math/Policy.h"
+
 #include <functional>
 #include <numeric>
 #include <utility>
 #include <cmath>
+#include <cstddef>
+#include <span>
 
 namespace nn {
 
-    template< class VarType >
+    template< class VarType, typename MathPolicy = math::Exact >
     struct TanhFunction {
         typedef VarType Var;
 
         template< typename V >
-        using use = TanhFunction< V >;
+        using use = TanhFunction< V, MathPolicy >;
 
         // 2 / (1 + exp(-2 * x)) - 1
         template< typename Iterator >
         Var calculate(const Var& sum, Iterator, Iterator) const {
-            return Var{2.f} / (Var{1.f} + std::exp(Var{-2.f} * sum)) - Var{1.f};
+            return Policy::tanh(sum);
+        }
+
+        void apply(std::span< const Var > in, std::span< Var > out) const {
+            Policy::tanh(in.data(), out.data(), in.size());
         }
 
         template< typename Iterator >
@@ -37,5 +45,14 @@ namespace nn {
         Var derivate(const Var& output) const {
             return Var{1.f} - output * output;
         }
+
+      private:
+        using Policy = math::select_policy_t< MathPolicy, Var >;
     };
+
+    template< class VarType >
+    using FastTanhFunction = TanhFunction< VarType, math::Polynomial >;
+
+    template< class VarType >
+    using LutTanhFunction = TanhFunction< VarType, math::LookupTable<> >;
 } // namespace nn
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 namespace nn {
 
     template< typename Func, unsigned int threshold >
@@ -21,6 +23,22 @@ namespace nn {
             return m_func.calculate(sum, begin, end) > t ? Var{1.0f} : Var{0.0f};
         }
 
+        /**
+         * Will apply the threshold to the outputs of the whole layer, only
+         * available if the wrapped function provides apply.
+         */
+        void apply(std::span< const Var > in, std::span< Var > out) const
+            requires requires(const Func& func, std::span< const Var > i, std::span< Var > o) {
+                func.apply(i, o);
+            }
+        {
+            const Var t = threshold / Var{100.f};
+            m_func.apply(in, out);
+            for(auto& value : out) {
+                value = value > t ? Var{1.0f} : Var{0.0f};
+            }
+        }
+
         template< typename Iterator >
         Var sum(Iterator begin, Iterator end, const Var& start) const {
             return m_func.sum(begin, end, start);
@@ -0,0 +1,48 @@
+#include "NeuralNetwork/ActivationFunction/Binary.h"
+#include "NeuralNetwork/ActivationFunction/BiopolarSigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/LogScaleSoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/ReluFunction.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+
+#include <array>
+#include <cstddef>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    TEMPLATE_TEST_CASE("layer wide activation matches the calculation per neuron",
+                       "[activation_function][apply]",
+                       nn::SigmoidFunction< float >,
+                       nn::TanhFunction< float >,
+                       nn::BiopolarSigmoidFunction< float >,
+                       nn::ReluFunction< float >,
+                       (nn::Binary< nn::SigmoidFunction< float >, 60 >),
+                       nn::LogScaleSoftmaxFunction< float >,
+                       nn::SigmoidFunction< double >,
+                       nn::TanhFunction< double >) {
+        using Var = typename TestType::Var;
+        const std::array< Var, 9 > dotProducts{-100, -20, -2.5, -0.5, 0, 0.25, 1, 3.5, 50};
+        std::array< Var, 9 > outputs{};
+
+        TestType function;
+        function.apply(dotProducts, outputs);
+        for(std::size_t i = 0; i < dotProducts.size(); ++i) {
+            const auto expected =
+             function.calculate(dotProducts[i], dotProducts.begin(), dotProducts.end());
+            REQUIRE(outputs[i] == Catch::Approx(expected).margin(1e-6));
+        }
+    }
+
+    TEST_CASE("log scale softmax divides the whole layer by its sum", "[activation_function][apply]") {
+        const std::array< float, 4 > dotProducts{1, 2, 3, 4};
+        std::array< float, 4 > outputs{};
+
+        nn::LogScaleSoftmaxFunction< float >{}.apply(dotProducts, outputs);
+        REQUIRE(outputs[0] == Catch::Approx(0.1f));
+        REQUIRE(outputs[1] == Catch::Approx(0.2f));
+        REQUIRE(outputs[2] == Catch::Approx(0.3f));
+        REQUIRE(outputs[3] == Catch::Approx(0.4f));
+    }
+} // namespace
@@ -0,0 +1,117 @@
+#include "NeuralNetwork/ActivationFunction/BiopolarSigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Math/FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    template< typename Var >
+    std::vector< Var > samples() {
+        std::vector< Var > values;
+        for(int i = -40000; i <= 40000; ++i) {
+            values.push_back(static_cast< Var >(i) / Var{1000});
+        }
+        return values;
+    }
+
+    template< typename Approximation, typename Exact >
+    void requireClose(double maxError) {
+        using Var = typename Exact::Var;
+        const auto dotProducts = samples< Var >();
+        std::vector< Var > outputs(dotProducts.size());
+        std::vector< Var > exactOutputs(dotProducts.size());
+        const Approximation approximation;
+        const Exact exact;
+
+        approximation.apply(dotProducts, outputs);
+        exact.apply(dotProducts, exactOutputs);
+
+        double error = 0;
+        for(std::size_t i = 0; i < dotProducts.size(); ++i) {
+            const auto expected = exact.calculate(dotProducts[i], dotProducts.begin(), dotProducts.end());
+            const auto actual =
+             approximation.calculate(dotProducts[i], dotProducts.begin(), dotProducts.end());
+            error = std::max(error, std::abs(static_cast< double >(actual - expected)));
+            error = std::max(error, std::abs(static_cast< double >(outputs[i] - exactOutputs[i])));
+        }
+        REQUIRE(error < maxError);
+    }
+
+    TEMPLATE_TEST_CASE("approximated activation functions stay close to the exact ones",
+                       "[activation_function][approximation]",
+                       float,
+                       double) {
+        GIVEN("the polynomial math policy") {
+            requireClose< nn::FastSigmoidFunction< TestType >, nn::SigmoidFunction< TestType > >(2e-6);
+            requireClose< nn::FastTanhFunction< TestType >, nn::TanhFunction< TestType > >(2e-6);
+            requireClose< nn::FastBiopolarSigmoidFunction< TestType >,
+                          nn::BiopolarSigmoidFunction< TestType > >(2e-6);
+        }
+        GIVEN("the lookup table math policy") {
+            requireClose< nn::LutSigmoidFunction< TestType >, nn::SigmoidFunction< TestType > >(2e-6);
+            requireClose< nn::LutTanhFunction< TestType >, nn::TanhFunction< TestType > >(5e-6);
+            requireClose< nn::LutBiopolarSigmoidFunction< TestType >,
+                          nn::BiopolarSigmoidFunction< TestType > >(5e-6);
+        }
+        GIVEN("a small lookup table") {
+            using Coarse = nn::SigmoidFunction< TestType, nn::math::LookupTable< 256, 8 > >;
+            requireClose< Coarse, nn::SigmoidFunction< TestType > >(5e-4);
+        }
+    }
+
+    SCENARIO("approximated activation functions keep the properties of the exact ones",
+             "[activation_function][approximation]") {
+        GIVEN("fast tanh and sigmoid") {
+            nn::FastTanhFunction< float > tanh;
+            nn::LutSigmoidFunction< float > sigmoid;
+            const std::array< float, 3 > range{};
+            THEN("they are exact in zero") {
+                REQUIRE(tanh.calculate(0.f, range.begin(), range.end()) == 0.f);
+                REQUIRE(sigmoid.calculate(0.f, range.begin(), range.end()) ==
+                        Catch::Approx(0.5f).margin(1e-6));
+            }
+            THEN("they saturate for large inputs") {
+                REQUIRE(tanh.calculate(1e6f, range.begin(), range.end()) ==
+                        Catch::Approx(1.f).margin(1e-6));
+                REQUIRE(tanh.calculate(-1e6f, range.begin(), range.end()) ==
+                        Catch::Approx(-1.f).margin(1e-6));
+                REQUIRE(sigmoid.calculate(1e6f, range.begin(), range.end()) ==
+                        Catch::Approx(1.f).margin(1e-6));
+                REQUIRE(sigmoid.calculate(-1e6f, range.begin(), range.end()) ==
+                        Catch::Approx(0.f).margin(1e-6));
+            }
+            THEN("the math policy is kept when the type changes") {
+                STATIC_REQUIRE(std::is_same_v< nn::FastTanhFunction< float >::use< double >,
+                                               nn::FastTanhFunction< double > >);
+            }
+        }
+    }
+
+    TEST_CASE("activation functions of fixed point numbers use the integer table",
+              "[activation_function][approximation][fixed]") {
+        using Fixed = nn::math::FixedPoint<>;
+        using Table = nn::math::IntegerLookupTable< 16, std::int32_t >;
+
+        const std::array< Fixed, 5 > dotProducts{Fixed(-3.5f), Fixed(-0.25f), Fixed{}, Fixed(0.75f), Fixed(9)};
+        std::array< Fixed, 5 > sigmoids;
+        std::array< Fixed, 5 > tanhs;
+        nn::SigmoidFunction< Fixed >{}.apply(dotProducts, sigmoids);
+        nn::FastTanhFunction< Fixed >{}.apply(dotProducts, tanhs);
+        for(std::size_t i = 0; i < dotProducts.size(); ++i) {
+            REQUIRE(sigmoids[i] == Table::sigmoid(dotProducts[i]));
+            REQUIRE(tanhs[i] == Table::tanh(dotProducts[i]));
+            REQUIRE(nn::LutSigmoidFunction< Fixed >{}.calculate(dotProducts[i], dotProducts.begin(), dotProducts.end()) ==
+                    Table::sigmoid(dotProducts[i]));
+        }
+    }
+} // namespace
@@ -1,7 +1,11 @@
 #include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
 
+#include <array>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <numeric>
+#include <vector>
 
 #define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
 #include <catch2/catch_all.hpp>
@@ -36,6 +40,31 @@ namespace {
                     }
                 }
             }
+            WHEN("the dot products are large") {
+                const std::array< float, 3 > dotProducts{1000.f, 1001.f, 1002.f};
+                THEN("the calculation does not overflow") {
+                    const float expected = 1.f / (1.f + std::exp(1.f) + std::exp(2.f));
+                    REQUIRE(softmax.calculate(dotProducts[0], dotProducts.begin(), dotProducts.end()) ==
+                            Catch::Approx(expected));
+                }
+            }
+            WHEN("the whole layer is calculated at once") {
+                const std::array< float, 5 > dotProducts{-3.f, 0.5f, 2.f, 700.f, 698.f};
+                std::array< float, 5 > outputs{};
+                softmax.apply(dotProducts, outputs);
+                THEN("the outputs are the same as the outputs of individual neurons") {
+                    for(std::size_t i = 0; i < outputs.size(); ++i) {
+                        REQUIRE(outputs[i] ==
+                                Catch::Approx(softmax.calculate(
+                                 dotProducts[i], dotProducts.begin(), dotProducts.end()))
+                                 .margin(1e-6));
+                    }
+                }
+                THEN("the outputs sum up to 1") {
+                    REQUIRE(std::accumulate(outputs.begin(), outputs.end(), 0.f) ==
+                            Catch::Approx(1.f));
+                }
+            }
         }
     }
 } // namespace
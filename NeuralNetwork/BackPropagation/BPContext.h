@@ -1,25 +1,49 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <tuple>
 
 #include <cereal/cereal.hpp>
 
 namespace nn::bp {
 
+namespace detail {
+    /// @brief a fully connected layer has size() x inputs() weights and a
+    /// bias per neuron, layers which share their weights tell how many they have.
+    template< typename Layer >
+    constexpr std::size_t weightsNumber() {
+        if constexpr(requires { Layer::weightsNumber(); }) {
+            return Layer::weightsNumber();
+        } else {
+            return Layer::size() * Layer::inputs();
+        }
+    }
+
+    template< typename Layer >
+    constexpr std::size_t biasesNumber() {
+        if constexpr(requires { Layer::biasesNumber(); }) {
+            return Layer::biasesNumber();
+        } else {
+            return Layer::size();
+        }
+    }
+} // namespace detail
+
 template< typename Var, typename LayersTuple >
 struct BPContext;
 
 template< typename Var, typename... Layers >
 struct BPContext< Var, std::tuple< Layers... > > {
     using Forward = std::tuple<std::array<Var, Layers::size()>...>;
-    using Gradients = std::tuple<std::array<Var, Layers::size() * Layers::inputs()>...>;
+    using Gradients = std::tuple<std::array<Var, detail::weightsNumber<Layers>()>...>;
+    using Biases = std::tuple<std::array<Var, detail::biasesNumber<Layers>()>...>;
 
     Forward outputs;
     Gradients weights;
-    Forward biases;
+    Biases biases;
     Forward deltas;
-    Forward biasGradients;
+    Biases biasGradients;
     Gradients weightGradients;
 };
 
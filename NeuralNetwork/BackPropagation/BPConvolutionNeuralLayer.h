@@ -49,6 +49,8 @@ namespace nn::bp {
         using Base::size;
         using Base::operator[];
         using Base::calculateOutputs;
+        using Base::calculateBatchOutputs;
+        using Base::patches;
 
         BPNeuralLayer() = default;
 
@@ -72,17 +74,14 @@ namespace nn::bp {
             auto& deltas = std::get< myIdx >(ctx.deltas);
             auto& weights = std::get< myIdx >(ctx.weights);
             auto& biases = std::get< myIdx >(ctx.biases);
-            auto& self = *this;
+            const auto& inputs = patches();
             for(const auto neuronId : ranges::views::indices(size())) {
-                auto& neuron = self[neuronId];
                 const Var neuronDelta = deltas[neuronId];
-
-                for(const auto weightId : ranges::views::indices(Grid::K::size)) {
-                    const Var inputValue = neuron[weightId].value;
-                    const Var weightGradient = neuronDelta * inputValue;
-                    weights[neuronId * Grid::K::size + weightId] -= learningRate * weightGradient;
-                }
-
+                // the window of the neuron is a row of the patch matrix
+                math::axpy(Var{-learningRate * neuronDelta},
+                           inputs.data() + neuronId * Grid::K::size,
+                           weights.data() + neuronId * Grid::K::size,
+                           Grid::K::size);
                 biases[neuronId] -= learningRate * neuronDelta;
             }
         }
@@ -92,15 +91,13 @@ namespace nn::bp {
             auto& deltas = std::get< myIdx >(ctx.deltas);
             auto& weightGrads = std::get< myIdx >(ctx.weightGradients);
             auto& biasGrads = std::get< myIdx >(ctx.biasGradients);
-            auto& self = *this;
+            const auto& inputs = patches();
             for(std::size_t neuronId = 0; neuronId < size(); ++neuronId) {
-                auto& neuron = self[neuronId];
                 const Var delta = deltas[neuronId];
-
-                for(std::size_t weightId = 0; weightId < Grid::K::size; ++weightId) {
-                    const Var inputValue = neuron[weightId].value;
-                    weightGrads[neuronId * Grid::K::size + weightId] += inputValue * delta;
-                }
+                math::axpy(delta,
+                           inputs.data() + neuronId * Grid::K::size,
+                           weightGrads.data() + neuronId * Grid::K::size,
+                           Grid::K::size);
                 biasGrads[neuronId] += delta;
             }
         }
@@ -124,6 +121,13 @@ namespace nn::bp {
             }
         }
 
+        /// @brief the errors of the outputs of the predecessor, every input
+        /// collects weight * delta of the window positions it belongs to.
+        template< typename Weights, typename Deltas, typename Errors >
+        void propagateErrors(const Weights& weights, const Deltas& deltas, Errors& errors) const {
+            Grid::col2im(weights.data(), deltas.data(), errors.data(), errors.size());
+        }
+
         template< typename BPCtx, std::size_t myIdx, std::size_t affIdx, typename AffectedLayer, typename MomentumFunc >
         void calculateHiddenDeltas(BPCtx& ctx, AffectedLayer& affectedLayer, MomentumFunc momentum) {
             detail::calculateHiddenDeltas< BPCtx, myIdx, affIdx >(*this, ctx, affectedLayer, momentum);
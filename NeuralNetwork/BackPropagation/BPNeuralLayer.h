@@ -1,10 +1,13 @@
 #pragma once
 
 #include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/Math/Gemm.h"
+#include "NeuralNetwork/Math/Sparse.h"
 
 #include <MPL/TypeTraits.h>
 
 #include <range/v3/all.hpp>
+#include <algorithm>
 #include <array>
 
 namespace nn::bp {
@@ -13,32 +16,51 @@ namespace nn::bp {
 
     namespace detail {
 
+        /// @brief the errors propagated back to the currentSize outputs of
+        /// the current layer, W^T * deltas of the affected layer.
+        template< typename BPCtx, std::size_t currentSize, std::size_t affectedIdx, typename AffectedLayer >
+        auto propagatedErrors(BPCtx& ctx, AffectedLayer& affectedLayer) {
+            using Var = typename AffectedLayer::Var;
+            auto& affectedDeltas = std::get< affectedIdx >(ctx.deltas);
+            const auto& affectedWeights = std::get< affectedIdx >(ctx.weights);
+            constexpr auto affectedInputs = affectedLayer.inputs();
+            constexpr auto affectedSize = affectedLayer.size();
+            constexpr auto connected = currentSize < affectedInputs ? currentSize : affectedInputs;
+
+            std::array< Var, currentSize > sums{};
+            if constexpr(requires { affectedLayer.propagateErrors(affectedWeights, affectedDeltas, sums); }) {
+                // the layer knows which of the inputs every weight belongs to
+                affectedLayer.propagateErrors(affectedWeights, affectedDeltas, sums);
+            } else {
+                math::gemv(math::Transpose::Yes,
+                           affectedSize,
+                           connected,
+                           Var{1},
+                           affectedWeights.data(),
+                           affectedInputs,
+                           affectedDeltas.data(),
+                           Var{0},
+                           sums.data());
+            }
+            return sums;
+        }
+
         template< typename BPCtx, std::size_t currentIdx, std::size_t affectedIdx, typename CurrentLayer, typename AffectedLayer, typename MomentumFunc >
         void calculateHiddenDeltas(CurrentLayer& currentLayer,
                                    BPCtx& ctx,
                                    AffectedLayer& affectedLayer,
                                    MomentumFunc momentum) {
-            using Var = typename AffectedLayer::Var;
             auto& funcs = currentLayer.activationFunctions();
             auto& outputFunc = std::get< 0 >(funcs);
             auto& currentDeltas = std::get< currentIdx >(ctx.deltas);
             auto& currentOutputs = std::get< currentIdx >(ctx.outputs);
-            auto& affectedDeltas = std::get< affectedIdx >(ctx.deltas);
-            const auto& affectedWeights = std::get< affectedIdx >(ctx.weights);
-            constexpr auto affectedInputs = affectedLayer.inputs();
-            constexpr auto affectedSize = affectedLayer.size();
+            constexpr auto currentSize = CurrentLayer::size();
 
-            currentLayer.for_each([&](auto i, auto&) {
-                Var sum{};
-                if (i.value < affectedInputs) {
-                    for (std::size_t j = 0; j < affectedSize; ++j) {
-                        sum += affectedDeltas[j] * affectedWeights[j * affectedInputs + i.value];
-                    }
-                }
-                currentDeltas[i.value] =
-                 momentum(currentDeltas[i.value],
-                          sum * outputFunc.derivate(currentOutputs[i.value]));
-            });
+            // the errors propagated back to this layer are W^T * deltas
+            const auto sums = propagatedErrors< BPCtx, currentSize, affectedIdx >(ctx, affectedLayer);
+            for(std::size_t i = 0; i < currentSize; ++i) {
+                currentDeltas[i] = momentum(currentDeltas[i], sums[i] * outputFunc.derivate(currentOutputs[i]));
+            }
         }
 
     } // namespace detail
@@ -54,6 +76,37 @@ namespace nn::bp {
       private:
         ActivationFunctions m_activationFunctions{};
 
+        /// @brief true for the layers which store only a part of the
+        /// weights, the other weights stay zero.
+        static constexpr bool sparse = requires(const Base& base) {
+            base.rowOffsets();
+            base.columns();
+        };
+
+        /// @brief weights += alpha * deltas * inputs^T, restricted to the
+        /// weights of the layer.
+        void updateWeights(Var alpha,
+                           const Var* deltas,
+                           const Var* inputs,
+                           std::size_t count,
+                           Var* weights) const {
+            if constexpr(sparse) {
+                // columns beyond count don't exist for a smaller predecessor
+                std::array< Var, NeuralLayerType::inputs() > padded{};
+                std::copy_n(inputs, count, padded.begin());
+                math::maskedGer(size(),
+                                Base::rowOffsets().data(),
+                                Base::columns().data(),
+                                alpha,
+                                deltas,
+                                padded.data(),
+                                weights,
+                                NeuralLayerType::inputs());
+            } else {
+                math::ger(size(), count, alpha, deltas, inputs, weights, NeuralLayerType::inputs());
+            }
+        }
+
       public:
         ActivationFunctions& activationFunctions() {
             return m_activationFunctions;
@@ -111,15 +164,8 @@ namespace nn::bp {
                 auto& predecessorOutputs = std::get< myIdx - 1 >(ctx.outputs);
                 const auto inputSize = predecessorOutputs.size() < inputsNumber
                                         ? predecessorOutputs.size() : inputsNumber;
-                for_each([&](auto i, auto&) {
-                    auto delta = deltas[i.value];
-                    for(std::size_t j = 0; j < inputSize; j++) {
-                        auto input = predecessorOutputs[j];
-                        auto weight = weights[i.value * inputsNumber + j];
-                        weights[i.value * inputsNumber + j] = weight - learningRate * input * delta;
-                    }
-                    biases[i.value] = biases[i.value] - learningRate * delta;
-                });
+                updateWeights(Var{-learningRate}, deltas.data(), predecessorOutputs.data(), inputSize, weights.data());
+                math::axpy(Var{-learningRate}, deltas.data(), biases.data(), size());
             } else {
                 for_each([&](auto i, auto& neuron) {
                     auto delta = deltas[i.value];
@@ -144,13 +190,8 @@ namespace nn::bp {
                 auto& predecessorOutputs = std::get< myIdx - 1 >(ctx.outputs);
                 const auto inputSize = predecessorOutputs.size() < inputsNumber
                                         ? predecessorOutputs.size() : inputsNumber;
-                for_each([&](auto i, auto&) {
-                    auto delta = deltas[i.value];
-                    for(std::size_t j = 0; j < inputSize; j++) {
-                        weightGrads[i.value * inputsNumber + j] += predecessorOutputs[j] * delta;
-                    }
-                    biasGrads[i.value] += delta;
-                });
+                updateWeights(Var{1}, deltas.data(), predecessorOutputs.data(), inputSize, weightGrads.data());
+                math::axpy(Var{1}, deltas.data(), biasGrads.data(), size());
             } else {
                 for_each([&](auto i, auto& neuron) {
                     auto delta = deltas[i.value];
@@ -169,18 +210,11 @@ namespace nn::bp {
             auto& biasGrads = std::get< myIdx >(ctx.biasGradients);
             auto& weights = std::get< myIdx >(ctx.weights);
             auto& biases = std::get< myIdx >(ctx.biases);
-            constexpr auto inputsNumber = inputs();
-
-            for_each([&](auto i, auto&) {
-                for(std::size_t j = 0; j < inputsNumber; j++) {
-                    weights[i.value * inputsNumber + j] -=
-                     learningRate * weightGrads[i.value * inputsNumber + j];
-                    weightGrads[i.value * inputsNumber + j] = Var{};
-                }
 
-                biases[i.value] -= learningRate * biasGrads[i.value];
-                biasGrads[i.value] = Var{};
-            });
+            math::axpy(Var{-learningRate}, weightGrads.data(), weights.data(), weights.size());
+            math::axpy(Var{-learningRate}, biasGrads.data(), biases.data(), biases.size());
+            weightGrads.fill(Var{});
+            biasGrads.fill(Var{});
         }
     };
 } // namespace nn::bp
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "NeuralNetwork/BackPropagation/BPNeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/PoolingLayer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace nn::bp {
+    template< typename >
+    struct BPNeuralLayer;
+
+    /**
+     * Back propagation of the pooling layer. The layer has no parameters,
+     * it only passes the errors of its outputs to the inputs they come
+     * from: max pooling routes the error of a window to the input recorded
+     * as its argmax, average pooling spreads it evenly over the window.
+     */
+    template< typename VarType, template< class > class PoolingAlgo, typename Grid >
+    struct BPNeuralLayer< nn::detail::PoolingLayer< VarType, PoolingAlgo, Grid > >
+     : private nn::detail::PoolingLayer< VarType, PoolingAlgo, Grid > {
+        using Base = nn::detail::PoolingLayer< VarType, PoolingAlgo, Grid >;
+
+        using Var = typename Base::Var;
+
+      private:
+        static constexpr bool average = std::is_base_of_v< Avg< Var >, typename Base::Algorithm >;
+        static_assert(Base::recordsArgmax || average,
+                      "the errors are propagated through the argmax of the pooling or evenly for an average");
+
+      public:
+        template< typename V >
+        using use = BPNeuralLayer< typename Base::template use< V > >;
+
+        template< std::size_t inputs >
+        using adjust = BPNeuralLayer;
+
+        using Base::biasesNumber;
+        using Base::calculateBatchOutputs;
+        using Base::calculateOutputs;
+        using Base::inputs;
+        using Base::size;
+        using Base::weightsNumber;
+
+        /// @brief the outputs are not activated, the delta of an output
+        /// layer is the error of the output.
+        template< typename BPCtx, std::size_t myIdx, typename Prototype, typename MomentumFunc >
+        void calculateDeltas(BPCtx& ctx, const Prototype& prototype, MomentumFunc momentum) {
+            const auto& outputs = std::get< myIdx >(ctx.outputs);
+            auto& deltas = std::get< myIdx >(ctx.deltas);
+            for(std::size_t i = 0; i < size(); ++i) {
+                deltas[i] = momentum(deltas[i], outputs[i] - std::get< 1 >(prototype)[i]);
+            }
+        }
+
+        template< typename BPCtx, std::size_t myIdx >
+        void calculateWeights(BPCtx&, const Var&) {
+        }
+
+        template< typename BPCtx, std::size_t myIdx >
+        void accumulateGradients(BPCtx&) {
+        }
+
+        template< typename BPCtx, std::size_t myIdx >
+        void applyGradients(BPCtx&, const Var&) {
+        }
+
+        /// @brief the errors of the outputs of the predecessor, the inputs
+        /// outside of every window get none.
+        template< typename Weights, typename Deltas, typename Errors >
+        void propagateErrors(const Weights&, const Deltas& deltas, Errors& errors) {
+            std::fill(errors.begin(), errors.end(), Var{});
+            if constexpr(Base::recordsArgmax) {
+                const auto& argmax = Base::argmax();
+                for(std::size_t w = 0; w < size(); ++w) {
+                    // the zero of the padding has no input
+                    if(argmax[w] < errors.size()) {
+                        errors[argmax[w]] += deltas[w];
+                    }
+                }
+            } else {
+                const std::size_t limit = std::min(errors.size(), Grid::size);
+                const auto& offsets = Grid::scatterOffsets();
+                const auto& scatter = Grid::scatter();
+                for(std::size_t i = 0; i < limit; ++i) {
+                    Var sum{};
+                    for(auto c = offsets[i]; c < offsets[i + 1]; ++c) {
+                        sum += deltas[scatter[c].window];
+                    }
+                    errors[i] = sum / static_cast< Var >(Grid::K::size);
+                }
+            }
+        }
+
+        template< typename BPCtx, std::size_t myIdx, std::size_t affIdx, typename AffectedLayer, typename MomentumFunc >
+        void calculateHiddenDeltas(BPCtx& ctx, AffectedLayer& affectedLayer, MomentumFunc momentum) {
+            auto& deltas = std::get< myIdx >(ctx.deltas);
+            const auto sums = detail::propagatedErrors< BPCtx, size(), affIdx >(ctx, affectedLayer);
+            for(std::size_t i = 0; i < size(); ++i) {
+                deltas[i] = momentum(deltas[i], sums[i]);
+            }
+        }
+    };
+
+} // namespace nn::bp
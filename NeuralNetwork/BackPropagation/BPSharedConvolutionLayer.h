@@ -0,0 +1,199 @@
+#pragma once
+
+#include "NeuralNetwork/BackPropagation/BPNeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/SharedConvolutionLayer.h"
+#include "NeuralNetwork/Math/Dot.h"
+#include "NeuralNetwork/Math/Gemm.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+
+namespace nn::bp {
+    template< typename >
+    struct BPNeuralLayer;
+
+    /**
+     * Back propagation of the weight shared convolution. The deltas are
+     * stored in the layout of the outputs, the gradient of a kernel is the
+     * sum of the gradients of all windows: deltas^T * patches.
+     */
+    template< typename OutputFunction, typename Grid, std::size_t channels, std::size_t inputChannels, Layout layout >
+    struct BPNeuralLayer< nn::detail::SharedConvolutionLayer< OutputFunction, Grid, channels, inputChannels, layout > >
+     : private nn::detail::SharedConvolutionLayer< OutputFunction, Grid, channels, inputChannels, layout > {
+        using Base = nn::detail::SharedConvolutionLayer< OutputFunction, Grid, channels, inputChannels, layout >;
+
+        using Var = typename Base::Var;
+        using ActivationFunctions = typename Base::ActivationFunctions;
+
+      private:
+        static constexpr auto windows = Grid::framesNumber;
+        static constexpr auto patchSize = Base::inputs();
+        static constexpr bool nhwc = layout == Layout::NHWC;
+
+        /// @brief op(deltas) is the (windows x channels) matrix.
+        static constexpr auto deltasTrans = nhwc ? math::Transpose::No : math::Transpose::Yes;
+        static constexpr std::size_t deltasLd = nhwc ? channels : windows;
+
+        ActivationFunctions m_activationFunctions{};
+        typename Base::Patches m_errors;
+
+        /// @brief weights += alpha * deltas^T * patches, biases += alpha *
+        /// the sums of the deltas of every channel.
+        template< typename Inputs >
+        void addGradients(Var alpha, const Inputs& inputs, const Var* deltas, Var* weights, Var* biases) {
+            const auto& patches = Base::lowered(inputs.data(), inputs.size());
+            math::gemm(deltasTrans == math::Transpose::No ? math::Transpose::Yes : math::Transpose::No,
+                       patches.trans,
+                       channels,
+                       patchSize,
+                       windows,
+                       alpha,
+                       deltas,
+                       deltasLd,
+                       patches.data,
+                       patches.ld,
+                       Var{1},
+                       weights,
+                       patchSize);
+            if constexpr(nhwc) {
+                for(std::size_t w = 0; w < windows; ++w) {
+                    math::axpy(alpha, deltas + w * channels, biases, channels);
+                }
+            } else {
+                for(std::size_t c = 0; c < channels; ++c) {
+                    Var sum{};
+                    for(std::size_t w = 0; w < windows; ++w) {
+                        sum += deltas[c * windows + w];
+                    }
+                    biases[c] += alpha * sum;
+                }
+            }
+        }
+
+      public:
+        ActivationFunctions& activationFunctions() {
+            return m_activationFunctions;
+        }
+
+        const ActivationFunctions& activationFunctions() const {
+            return m_activationFunctions;
+        }
+
+        template< typename VarType >
+        using use = BPNeuralLayer< typename Base::template use< VarType > >;
+
+        template< std::size_t inputs >
+        using adjust = BPNeuralLayer;
+
+        using Base::biases;
+        using Base::biasesNumber;
+        using Base::calculateBatchOutputs;
+        using Base::calculateOutputs;
+        using Base::inputs;
+        using Base::kernels;
+        using Base::lowered;
+        using Base::patches;
+        using Base::size;
+        using Base::weightsNumber;
+
+        template< typename BPCtx, std::size_t myIdx, typename Prototype, typename MomentumFunc >
+        void calculateDeltas(BPCtx& ctx, const Prototype& prototype, MomentumFunc momentum) {
+            auto& outputFunc = std::get< 0 >(m_activationFunctions);
+            auto& outputs = std::get< myIdx >(ctx.outputs);
+            auto& deltas = std::get< myIdx >(ctx.deltas);
+            for(std::size_t neuronId = 0; neuronId < size(); ++neuronId) {
+                deltas[neuronId] = momentum(deltas[neuronId],
+                                            outputFunc.delta(outputs[neuronId],
+                                                             std::get< 1 >(prototype)[neuronId]));
+            }
+        }
+
+        template< typename BPCtx, std::size_t myIdx >
+        void calculateWeights(BPCtx& ctx, const Var& learningRate) {
+            addGradients(Var{-learningRate},
+                         std::get< myIdx - 1 >(ctx.outputs),
+                         std::get< myIdx >(ctx.deltas).data(),
+                         std::get< myIdx >(ctx.weights).data(),
+                         std::get< myIdx >(ctx.biases).data());
+        }
+
+        template< typename BPCtx, std::size_t myIdx >
+        void accumulateGradients(BPCtx& ctx) {
+            addGradients(Var{1},
+                         std::get< myIdx - 1 >(ctx.outputs),
+                         std::get< myIdx >(ctx.deltas).data(),
+                         std::get< myIdx >(ctx.weightGradients).data(),
+                         std::get< myIdx >(ctx.biasGradients).data());
+        }
+
+        template< typename BPCtx, std::size_t myIdx >
+        void applyGradients(BPCtx& ctx, const Var& learningRate) {
+            auto& weightGrads = std::get< myIdx >(ctx.weightGradients);
+            auto& biasGrads = std::get< myIdx >(ctx.biasGradients);
+            auto& weights = std::get< myIdx >(ctx.weights);
+            auto& biases = std::get< myIdx >(ctx.biases);
+            math::axpy(Var{-learningRate}, weightGrads.data(), weights.data(), weights.size());
+            math::axpy(Var{-learningRate}, biasGrads.data(), biases.data(), biases.size());
+            weightGrads.fill(Var{});
+            biasGrads.fill(Var{});
+        }
+
+        /// @brief the errors of the outputs of the predecessor. The errors
+        /// of the window positions are deltas * kernels, every input
+        /// collects the errors of the positions it belongs to.
+        template< typename Weights, typename Deltas, typename Errors >
+        void propagateErrors(const Weights& weights, const Deltas& deltas, Errors& errors) {
+            if(Base::pointwise && errors.size() >= windows * inputChannels) {
+                // pointwise, the errors of the patch matrix are the errors of
+                // the inputs, transposed for NCHW
+                std::fill(errors.begin() + windows * inputChannels, errors.end(), Var{});
+                if constexpr(nhwc) {
+                    multiplyErrors(deltas.data(), weights.data(), errors.data());
+                } else {
+                    math::gemm(math::Transpose::Yes,
+                               deltasTrans == math::Transpose::No ? math::Transpose::Yes : math::Transpose::No,
+                               patchSize,
+                               windows,
+                               channels,
+                               Var{1},
+                               weights.data(),
+                               patchSize,
+                               deltas.data(),
+                               deltasLd,
+                               Var{0},
+                               errors.data(),
+                               windows);
+                }
+                return;
+            }
+            multiplyErrors(deltas.data(), weights.data(), m_errors.data());
+            Base::col2im(m_errors.data(), errors.data(), errors.size());
+        }
+
+        template< typename BPCtx, std::size_t myIdx, std::size_t affIdx, typename AffectedLayer, typename MomentumFunc >
+        void calculateHiddenDeltas(BPCtx& ctx, AffectedLayer& affectedLayer, MomentumFunc momentum) {
+            detail::calculateHiddenDeltas< BPCtx, myIdx, affIdx >(*this, ctx, affectedLayer, momentum);
+        }
+
+      private:
+        /// @brief (windows x inputs()) errors = deltas * kernels.
+        static void multiplyErrors(const Var* deltas, const Var* weights, Var* errors) {
+            math::gemm(deltasTrans,
+                       math::Transpose::No,
+                       windows,
+                       patchSize,
+                       channels,
+                       Var{1},
+                       deltas,
+                       deltasLd,
+                       weights,
+                       patchSize,
+                       Var{0},
+                       errors,
+                       patchSize);
+        }
+    };
+
+} // namespace nn::bp
@@ -3,13 +3,18 @@
 #include "NeuralNetwork/BackPropagation/BPContext.h"
 #include "NeuralNetwork/BackPropagation/BPNeuralLayer.h"
 #include "NeuralNetwork/BackPropagation/BPConvolutionNeuralLayer.h"
+#include "NeuralNetwork/BackPropagation/BPPoolingLayer.h"
+#include "NeuralNetwork/BackPropagation/BPSharedConvolutionLayer.h"
 #include "NeuralNetwork/BackPropagation/ErrorFunction.h"
+#include "NeuralNetwork/Utils/Batch.h"
 
 #include <System/Time.h>
 
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <iterator>
+#include <span>
 
 namespace nn::bp {
 
@@ -24,6 +29,7 @@ namespace nn::bp {
         using Perceptron = typename PerceptronType::template wrap< BPNeuralLayer >;
         using Layers = typename Perceptron::Layers;
         using BPCtx = BPContext< Var, Layers >;
+        using BatchContext = nn::detail::batch_context_t< typename BPCtx::Forward >;
 
       public:
         using Prototype =
@@ -130,11 +136,73 @@ namespace nn::bp {
         const BPCtx& context() const { return m_bpContext; }
         BPCtx& context() { return m_bpContext; }
 
+        /// @brief removes the weights of the sparse layers whose magnitude is
+        /// not above the threshold. The removed weights are set to zero in
+        /// the context and stay zero during the following training.
+        void prune(Var threshold) {
+            utils::for_< size() - 1 >([this, threshold](auto i) {
+                constexpr auto idx = i.value + 1;
+                auto& layer = std::get< idx >(m_layers);
+                auto& weights = std::get< idx >(m_bpContext.weights);
+                const auto& biases = std::get< idx >(m_bpContext.biases);
+                if constexpr(requires { layer.prune(weights.data(), biases.data(), threshold); }) {
+                    layer.prune(weights.data(), biases.data(), threshold);
+                    layer.mask(weights.data());
+                }
+            });
+        }
+
         template< typename Iterator, typename OutputIterator >
         void evaluate(Iterator begin, Iterator end, OutputIterator out) {
             forwardPass(begin, end, out);
         }
 
+        /// @brief evaluates directly from the buffer of the caller, see
+        /// Perceptron::evaluate.
+        void evaluate(std::span< const Var > features, std::span< Var > out) {
+            auto& inputLayer = std::get< 0 >(m_layers);
+            inputLayer.template calculateOutputs< typename BPCtx::Forward, 0 >(m_bpContext.outputs, features);
+            propagate();
+
+            const auto& outputCtx = std::get< size() - 1U >(m_bpContext.outputs);
+            std::copy(outputCtx.begin(), outputCtx.end(), out.begin());
+        }
+
+        /// @brief evaluates a batch of samples stored one after another,
+        /// see Perceptron::evaluateBatch.
+        template< typename Iterator, typename OutputIterator >
+        void evaluateBatch(Iterator begin, std::size_t batchSize, OutputIterator out) {
+            if(batchSize == 0) {
+                return;
+            }
+
+            using Forward = typename BPCtx::Forward;
+            nn::detail::resize< Forward >(m_batchContext, batchSize);
+
+            auto& inputLayer = std::get< 0 >(m_layers);
+            auto& inputRows = std::get< 0 >(m_batchContext);
+            const auto& inputOutputs = std::get< 0 >(m_bpContext.outputs);
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                auto end = std::next(begin, inputsNumber);
+                setInputs(begin, end);
+                begin = end;
+
+                inputLayer.template calculateOutputs< Forward, 0 >(m_bpContext.outputs);
+                std::copy(inputOutputs.begin(),
+                          inputOutputs.end(),
+                          inputRows.begin() + sample * inputOutputs.size());
+            }
+
+            utils::for_< size() - 1U >([this, batchSize](auto i) {
+                auto& layer = std::get< i.value + 1 >(m_layers);
+                nn::detail::calculateBatchOutputs< i.value + 1, i.value >(
+                 layer, m_batchContext, m_bpContext.outputs, batchSize, m_bpContext);
+            });
+
+            const auto& outputRows = std::get< size() - 1U >(m_batchContext);
+            std::copy(outputRows.begin(), outputRows.end(), out);
+        }
+
         template< typename Iterator, typename ErrorFunc, typename MomentumFunc >
         void calculate(Iterator begin,
                        Iterator end,
@@ -178,6 +246,29 @@ namespace nn::bp {
 
         template< typename Iterator, typename OutputIterator >
         void forwardPass(Iterator begin, Iterator end, OutputIterator out) {
+            setInputs(begin, end);
+
+            auto& inputLayer0 = std::get< 0 >(m_layers);
+            inputLayer0.template calculateOutputs< typename BPCtx::Forward, 0 >(m_bpContext.outputs);
+            propagate();
+
+            auto& outputCtx = std::get< size() - 1U >(m_bpContext.outputs);
+            for(const auto& val : outputCtx) {
+                *out = val;
+                ++out;
+            }
+        }
+
+        /// @brief calculates the outputs of all layers after the input one.
+        void propagate() {
+            utils::for_< size() - 1U >([this](auto i) {
+                auto& layer = std::get< i.value + 1 >(m_layers);
+                layer.template calculateOutputs< typename BPCtx::Forward, i.value + 1, i.value >(m_bpContext.outputs, m_bpContext);
+            });
+        }
+
+        template< typename Iterator >
+        void setInputs(Iterator begin, Iterator end) {
             auto& inputLayer = std::get< 0 >(m_layers);
             unsigned int inputId = 0;
             while(begin != end) {
@@ -190,20 +281,6 @@ namespace nn::bp {
                 begin++;
                 inputId++;
             }
-
-            auto& inputLayer0 = std::get< 0 >(m_layers);
-            inputLayer0.template calculateOutputs< typename BPCtx::Forward, 0 >(m_bpContext.outputs);
-
-            utils::for_< size() - 1U >([this](auto i) {
-                auto& layer = std::get< i.value + 1 >(m_layers);
-                layer.template calculateOutputs< typename BPCtx::Forward, i.value + 1, i.value >(m_bpContext.outputs, m_bpContext);
-            });
-
-            auto& outputCtx = std::get< size() - 1U >(m_bpContext.outputs);
-            for(const auto& val : outputCtx) {
-                *out = val;
-                ++out;
-            }
         }
 
         Layers m_layers{};
@@ -211,6 +288,7 @@ namespace nn::bp {
         std::array< Var, outputsNumber > m_outputs;
         ErrorCalculator< typename PerceptronType::VarType > m_errorCalculator;
         BPCtx m_bpContext{};
+        BatchContext m_batchContext;
 
         struct DummyMomentum {
             Var operator()(const Var& oldDelta, const Var& newDelta) {
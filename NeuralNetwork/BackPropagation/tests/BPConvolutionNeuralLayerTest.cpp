@@ -70,4 +70,36 @@ namespace {
             }
         }
     }
+
+    SCENARIO("BPConvolutionNeuralLayer propagates the errors to the windows of the inputs",
+             "[layer][convolution][backward]") {
+        GIVEN("A BPConvolutionNeuralLayer with 9 neurons and kernel 3x3") {
+            const auto layer = BPConvolutionNeuralLayer{};
+            std::array< float, 9 * 9 > weights;
+            std::array< float, 9 > deltas;
+            for(std::size_t i = 0; i < weights.size(); ++i) {
+                weights[i] = static_cast< float >(i % 7) - 3.f;
+            }
+            for(std::size_t i = 0; i < deltas.size(); ++i) {
+                deltas[i] = 0.1f * static_cast< float >(i + 1);
+            }
+
+            WHEN("the errors of a 5x5 predecessor are calculated") {
+                std::array< float, width * height > errors;
+                layer.propagateErrors(weights, deltas, errors);
+
+                THEN("every input gets the weighted deltas of the windows it belongs to") {
+                    for(std::size_t input = 0; input < errors.size(); ++input) {
+                        float expected = 0.f;
+                        for(std::size_t w = 0; w < SlidingWindow::framesNumber; ++w) {
+                            if(SlidingWindow::contains(input, w)) {
+                                expected += weights[w * 9 + SlidingWindow::localize(input, w)] * deltas[w];
+                            }
+                        }
+                        REQUIRE_THAT(errors[input], Catch::Matchers::WithinAbs(expected, 1e-5f));
+                    }
+                }
+            }
+        }
+    }
 } // namespace
@@ -0,0 +1,107 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/BackPropagation/tests/NumericGradients.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/PoolingLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Neuron/PoolingNeuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using nn::bp::test::numericGradients;
+
+    template< template< class > class PoolingAlgo, typename Grid >
+    struct Network {
+        using Pooling = nn::PoolingLayer< PoolingAlgo, Grid >;
+
+        /// @brief pooling between two trained layers.
+        using Hidden = nn::Perceptron< double,
+                                       nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                                       nn::NeuralLayer< nn::Neuron, nn::TanhFunction, Grid::size >,
+                                       Pooling,
+                                       nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 3 > >;
+
+        /// @brief pooling as the output layer.
+        using Output = nn::Perceptron< double,
+                                       nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                                       nn::NeuralLayer< nn::Neuron, nn::TanhFunction, Grid::size >,
+                                       Pooling >;
+    };
+
+    template< typename Perceptron >
+    void requireGradients(const std::vector< double >& outputs) {
+        using Algo = nn::bp::BepAlgorithm< Perceptron >;
+        using Input = typename Perceptron::Input;
+
+        Algo algorithm(0.1);
+        auto& ctx = algorithm.context();
+        for(std::size_t i = 0; i < std::get< 1 >(ctx.weights).size(); ++i) {
+            std::get< 1 >(ctx.weights)[i] = 0.5 * std::cos(static_cast< double >(i));
+        }
+
+        typename Algo::Prototype prototype{{Input{{0.1}}, Input{{-0.4}}, Input{{0.7}}, Input{{0.2}}}, {}};
+        std::copy_n(outputs.begin(), std::get< 1 >(prototype).size(), std::get< 1 >(prototype).begin());
+
+        REQUIRE(std::get< 2 >(ctx.weights).empty());
+        REQUIRE(std::get< 2 >(ctx.biases).empty());
+
+        const auto weights = numericGradients(algorithm, prototype, std::get< 1 >(ctx.weights));
+        const auto biases = numericGradients(algorithm, prototype, std::get< 1 >(ctx.biases));
+        algorithm.executeBatchTrainingStep(prototype, [](double, double delta) { return delta; });
+
+        for(std::size_t i = 0; i < weights.size(); ++i) {
+            REQUIRE_THAT(std::get< 1 >(ctx.weightGradients)[i], Catch::Matchers::WithinAbs(weights[i], 1e-7));
+        }
+        for(std::size_t i = 0; i < biases.size(); ++i) {
+            REQUIRE_THAT(std::get< 1 >(ctx.biasGradients)[i], Catch::Matchers::WithinAbs(biases[i], 1e-7));
+        }
+    }
+
+    TEMPLATE_TEST_CASE("Pooling passes the errors to the inputs its outputs come from",
+                       "[bp][pooling]",
+                       (Network< nn::Max, nn::SlidingWindow< 5, 4, nn::Kernel< 2, 2, 2 > > >),
+                       (Network< nn::Max, nn::SlidingWindow< 4, 4, nn::Kernel< 3, 3, 1 > > >),
+                       (Network< nn::SlidingMax, nn::SlidingWindow< 4, 4, nn::Kernel< 3, 3, 1 > > >),
+                       (Network< nn::Avg, nn::SlidingWindow< 5, 4, nn::Kernel< 2, 2, 2 > > >),
+                       (Network< nn::Avg, nn::SlidingWindow< 4, 4, nn::Kernel< 3, 3, 1 > > >),
+                       (Network< nn::SummedAreaAvg, nn::SlidingWindow< 4, 4, nn::Kernel< 3, 3, 1 > > >)) {
+        SECTION("the gradients of the layer before a hidden pooling layer are the derivatives of the error") {
+            requireGradients< typename TestType::Hidden >({0.2, 0.9, 0.5});
+        }
+
+        SECTION("the gradients of the layer before an output pooling layer are the derivatives of the error") {
+            std::vector< double > outputs;
+            for(std::size_t i = 0; i < TestType::Pooling::size(); ++i) {
+                outputs.push_back(0.3 * std::sin(static_cast< double >(i)));
+            }
+            requireGradients< typename TestType::Output >(outputs);
+        }
+    }
+
+    TEST_CASE("Max pooling routes the error of a window to its maximum only", "[bp][pooling]") {
+        using Grid = nn::SlidingWindow< 4, 2, nn::Kernel< 2, 2, 2 > >;
+        using Layer = nn::bp::BPNeuralLayer< nn::PoolingLayer< nn::Max, Grid, double > >;
+        using Context = std::tuple< std::array< double, 8 >, std::array< double, 2 > >;
+
+        Layer layer;
+        Context ctx{{1, 5, -2, -1, 3, 2, -3, -4}, {}};
+        layer.calculateOutputs< Context, 1, 0 >(ctx);
+
+        const std::array< double, 0 > weights{};
+        const std::array< double, 2 > deltas{0.5, -2};
+        std::array< double, 8 > errors;
+        layer.propagateErrors(weights, deltas, errors);
+        REQUIRE(errors == std::array< double, 8 >{0, 0.5, 0, -2, 0, 0, 0, 0});
+    }
+} // namespace
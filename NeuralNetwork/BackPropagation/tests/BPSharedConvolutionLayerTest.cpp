@@ -0,0 +1,98 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/BackPropagation/tests/NumericGradients.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/SharedConvolutionLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using nn::bp::test::numericGradients;
+
+    template< typename Grid, std::size_t channels, std::size_t inputChannels, nn::Layout layout >
+    struct Network {
+        using Perceptron =
+         nn::Perceptron< double,
+                         nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                         nn::NeuralLayer< nn::Neuron, nn::TanhFunction, Grid::size * inputChannels >,
+                         nn::SharedConvolutionLayer< nn::TanhFunction, Grid, channels, inputChannels, layout >,
+                         nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 3 > >;
+
+        using Algo = nn::bp::BepAlgorithm< Perceptron >;
+        using Input = typename Perceptron::Input;
+        static constexpr std::size_t weights = Grid::K::size * inputChannels * channels;
+        static constexpr std::size_t biases = channels;
+    };
+
+    TEMPLATE_TEST_CASE("Shared convolution kernels are trained with the gradients of all windows",
+                       "[bp][convolution][shared]",
+                       (Network< nn::SlidingWindow< 6, 6, nn::Kernel< 3, 3, 1 > >, 2, 1, nn::Layout::NHWC >),
+                       (Network< nn::SlidingWindow< 5, 4, nn::Kernel< 3, 2, 2 > >, 3, 2, nn::Layout::NHWC >),
+                       (Network< nn::SlidingWindow< 5, 4, nn::Kernel< 3, 2, 2 > >, 3, 2, nn::Layout::NCHW >),
+                       (Network< nn::SlidingWindow< 5, 4, nn::Kernel< 3, 3, 1 > >, 2, 3, nn::Layout::NCHW >),
+                       (Network< nn::SlidingWindow< 12, 10, nn::Kernel< 9, 9, 1 > >, 3, 2, nn::Layout::NCHW >),
+                       (Network< nn::SlidingWindow< 3, 3, nn::Kernel< 1, 1, 1 > >, 2, 3, nn::Layout::NHWC >),
+                       (Network< nn::SlidingWindow< 3, 3, nn::Kernel< 1, 1, 1 > >, 2, 3, nn::Layout::NCHW >)) {
+        using Algo = typename TestType::Algo;
+        using Input = typename TestType::Input;
+
+        Algo algorithm(0.1);
+        auto& ctx = algorithm.context();
+        for(std::size_t i = 0; i < std::get< 2 >(ctx.weights).size(); ++i) {
+            std::get< 2 >(ctx.weights)[i] = 0.3 * std::sin(static_cast< double >(i));
+        }
+        for(std::size_t i = 0; i < std::get< 1 >(ctx.weights).size(); ++i) {
+            std::get< 1 >(ctx.weights)[i] = 0.5 * std::cos(static_cast< double >(i));
+        }
+
+        const typename Algo::Prototype prototype{{Input{{0.1}}, Input{{-0.4}}, Input{{0.7}}, Input{{0.2}}},
+                                                 {0.2, 0.9, 0.5}};
+
+        SECTION("the context keeps one kernel and one bias per channel") {
+            REQUIRE(std::get< 2 >(ctx.weights).size() == TestType::weights);
+            REQUIRE(std::get< 2 >(ctx.biases).size() == TestType::biases);
+        }
+
+        const auto kernels = numericGradients(algorithm, prototype, std::get< 2 >(ctx.weights));
+        const auto biases = numericGradients(algorithm, prototype, std::get< 2 >(ctx.biases));
+        const auto dense = numericGradients(algorithm, prototype, std::get< 1 >(ctx.weights));
+        algorithm.executeBatchTrainingStep(prototype, [](double, double delta) { return delta; });
+
+        SECTION("the gradients of the kernels are the derivatives of the error") {
+            for(std::size_t i = 0; i < kernels.size(); ++i) {
+                REQUIRE_THAT(std::get< 2 >(ctx.weightGradients)[i], Catch::Matchers::WithinAbs(kernels[i], 1e-7));
+            }
+            for(std::size_t i = 0; i < biases.size(); ++i) {
+                REQUIRE_THAT(std::get< 2 >(ctx.biasGradients)[i], Catch::Matchers::WithinAbs(biases[i], 1e-7));
+            }
+        }
+
+        SECTION("the errors are propagated through the shared kernels to the predecessor") {
+            for(std::size_t i = 0; i < dense.size(); ++i) {
+                REQUIRE_THAT(std::get< 1 >(ctx.weightGradients)[i], Catch::Matchers::WithinAbs(dense[i], 1e-7));
+            }
+        }
+
+        SECTION("the accumulated gradients are applied to the kernels") {
+            const auto before = std::get< 2 >(ctx.weights);
+            const auto gradients = std::get< 2 >(ctx.weightGradients);
+            algorithm.applyBatchGradients();
+            for(std::size_t i = 0; i < before.size(); ++i) {
+                REQUIRE_THAT(std::get< 2 >(ctx.weights)[i],
+                             Catch::Matchers::WithinAbs(before[i] - 0.1 * gradients[i], 1e-12));
+                REQUIRE(std::get< 2 >(ctx.weightGradients)[i] == 0.0);
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,97 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <MPL/Algorithm.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                     nn::SparseNeuralLayer< nn::Neuron, nn::TanhFunction, 16 >,
+                     nn::SparseNeuralLayer< nn::Neuron, nn::SigmoidFunction, 2 > >;
+
+    using Algorithm = nn::bp::BepAlgorithm< Perceptron >;
+
+    SCENARIO("BepAlgorithm trains pruned sparse layers", "[bp][sparse]") {
+        GIVEN("an algorithm with pruned sparse layers") {
+            Algorithm algorithm(0.5f);
+            auto& weights = std::get< 1 >(algorithm.context().weights);
+            for(std::size_t i = 0; i < weights.size(); ++i) {
+                weights[i] = std::sin(static_cast< float >(i + 1));
+            }
+            algorithm.prune(0.7f);
+
+            std::vector< std::size_t > pruned;
+            for(std::size_t i = 0; i < weights.size(); ++i) {
+                if(std::abs(std::sin(static_cast< float >(i + 1))) <= 0.7f) {
+                    REQUIRE(weights[i] == 0.f);
+                    pruned.push_back(i);
+                }
+            }
+            REQUIRE(!pruned.empty());
+
+            const std::array< Algorithm::Prototype, 4 > prototypes{
+             Algorithm::Prototype{{{{0.f}, {1.f}, {0.f}, {1.f}}}, {1.f, 0.f}},
+             Algorithm::Prototype{{{{1.f}, {0.f}, {1.f}, {0.f}}}, {0.f, 1.f}},
+             Algorithm::Prototype{{{{1.f}, {1.f}, {0.f}, {0.f}}}, {1.f, 1.f}},
+             Algorithm::Prototype{{{{0.f}, {0.f}, {1.f}, {1.f}}}, {0.f, 0.f}}};
+
+            WHEN("the algorithm is trained") {
+                float firstError = 0.f;
+                float lastError = 0.f;
+                for(std::size_t epoch = 0; epoch < 300; ++epoch) {
+                    float error = 0.f;
+                    for(const auto& prototype : prototypes) {
+                        error += algorithm.executeTrainingStep(prototype, [](float, float delta) {
+                            return delta;
+                        });
+                    }
+                    firstError = epoch == 0 ? error : firstError;
+                    lastError = error;
+                }
+
+                THEN("the error decreases and the pruned weights stay zero") {
+                    REQUIRE(lastError < firstError);
+                    for(auto i : pruned) {
+                        REQUIRE(weights[i] == 0.f);
+                    }
+                }
+
+                THEN("a perceptron pruned from the context gives the same outputs") {
+                    Perceptron perceptron;
+                    utils::for_< Perceptron::size() - 1 >([&](auto i) {
+                        constexpr auto idx = i.value + 1;
+                        std::get< idx >(perceptron.layers())
+                         .prune(std::get< idx >(algorithm.context().weights).data(),
+                                std::get< idx >(algorithm.context().biases).data(),
+                                0.f);
+                    });
+
+                    for(const auto& prototype : prototypes) {
+                        std::array< float, 2 > expected;
+                        std::array< float, 2 > actual;
+                        const auto& inputs = std::get< 0 >(prototype);
+                        algorithm.evaluate(inputs.begin(), inputs.end(), expected.begin());
+                        perceptron.evaluate(inputs.begin(), inputs.end(), actual.begin());
+                        REQUIRE(actual[0] == Catch::Approx(expected[0]).epsilon(1e-5));
+                        REQUIRE(actual[1] == Catch::Approx(expected[1]).epsilon(1e-5));
+                    }
+                }
+            }
+        }
+    }
+} // namespace
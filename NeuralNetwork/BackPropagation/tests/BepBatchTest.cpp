@@ -0,0 +1,56 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 2 > >;
+
+    using Input = Perceptron::Input;
+
+    SCENARIO("BepAlgorithm evaluates a batch of samples", "[bp][batch]") {
+        GIVEN("a BepAlgorithm with randomly initialized weights") {
+            nn::bp::BepAlgorithm< Perceptron > algorithm(0.1f);
+            constexpr std::size_t batchSize = 3;
+
+            std::vector< Input > inputs;
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                for(std::size_t i = 0; i < Perceptron::inputs(); ++i) {
+                    inputs.push_back(Input{{static_cast< float >(sample + i) / 4.f}});
+                }
+            }
+
+            WHEN("evaluateBatch is called") {
+                std::vector< float > batchOutputs(batchSize * Perceptron::outputs());
+                algorithm.evaluateBatch(inputs.begin(), batchSize, batchOutputs.begin());
+
+                THEN("the outputs are the same as for the evaluation sample by sample") {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        std::array< float, Perceptron::outputs() > outputs;
+                        auto begin = inputs.begin() + sample * Perceptron::inputs();
+                        algorithm.evaluate(begin, begin + Perceptron::inputs(), outputs.begin());
+
+                        for(std::size_t i = 0; i < outputs.size(); ++i) {
+                            REQUIRE(batchOutputs[sample * Perceptron::outputs() + i] ==
+                                    Catch::Approx(outputs[i]).epsilon(1e-5));
+                        }
+                    }
+                }
+            }
+        }
+    }
+} // namespace
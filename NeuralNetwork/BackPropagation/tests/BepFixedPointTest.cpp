@@ -0,0 +1,68 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/Math/FixedPoint.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <MPL/Algorithm.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Fixed = nn::math::FixedPoint<>;
+
+    template< typename Var >
+    using Perceptron =
+     nn::Perceptron< Var,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 2 > >;
+
+    SCENARIO("BepAlgorithm evaluates with fixed point numbers", "[bp][fixed]") {
+        GIVEN("a float algorithm and a fixed point one with the same weights") {
+            nn::bp::BepAlgorithm< Perceptron< float > > reference(0.1f);
+            nn::bp::BepAlgorithm< Perceptron< Fixed > > algorithm(Fixed(0.1f));
+            utils::for_< Perceptron< float >::size() >([&](auto i) {
+                const auto& weights = std::get< i.value >(reference.context().weights);
+                const auto& biases = std::get< i.value >(reference.context().biases);
+                auto& fixedWeights = std::get< i.value >(algorithm.context().weights);
+                auto& fixedBiases = std::get< i.value >(algorithm.context().biases);
+                for(std::size_t w = 0; w < weights.size(); ++w) {
+                    fixedWeights[w] = Fixed(weights[w]);
+                }
+                for(std::size_t b = 0; b < biases.size(); ++b) {
+                    fixedBiases[b] = Fixed(biases[b]);
+                }
+            });
+
+            std::array< Perceptron< float >::Input, Perceptron< float >::inputs() > floatInputs;
+            std::array< Perceptron< Fixed >::Input, Perceptron< Fixed >::inputs() > fixedInputs;
+            for(std::size_t i = 0; i < floatInputs.size(); ++i) {
+                floatInputs[i].value[0] = std::cos(static_cast< float >(i));
+                fixedInputs[i].value[0] = Fixed(floatInputs[i].value[0]);
+            }
+
+            WHEN("both are evaluated") {
+                std::array< float, Perceptron< float >::outputs() > expected;
+                std::array< Fixed, Perceptron< Fixed >::outputs() > actual;
+                reference.evaluate(floatInputs.begin(), floatInputs.end(), expected.begin());
+                algorithm.evaluate(fixedInputs.begin(), fixedInputs.end(), actual.begin());
+
+                THEN("the outputs are close to the float ones") {
+                    for(std::size_t i = 0; i < expected.size(); ++i) {
+                        REQUIRE(static_cast< float >(actual[i]) == Catch::Approx(expected[i]).margin(1e-3));
+                    }
+                }
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,45 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Perceptron/Model.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <array>
+#include <cstddef>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 8 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 6 >,
+                     nn::SparseNeuralLayer< nn::Neuron, nn::SigmoidFunction, 2 > >;
+
+    SCENARIO("Model takes the weights of a back propagation context", "[bp][model]") {
+        GIVEN("a BepAlgorithm with randomly initialized weights") {
+            nn::bp::BepAlgorithm< Perceptron > algorithm(0.1f);
+            const std::array< float, 4 > features{0.3f, -0.7f, 0.1f, 0.9f};
+
+            WHEN("a model is built from the context") {
+                const nn::Model< Perceptron > model(algorithm.context());
+                nn::InferenceSession< Perceptron > session(model);
+
+                std::array< float, 2 > expected;
+                std::array< float, 2 > actual;
+                algorithm.evaluate(features, expected);
+                session.evaluate(features, actual);
+
+                THEN("the model evaluates the same outputs as the algorithm") {
+                    REQUIRE(actual[0] == Catch::Approx(expected[0]).epsilon(1e-6));
+                    REQUIRE(actual[1] == Catch::Approx(expected[1]).epsilon(1e-6));
+                }
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,44 @@
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <array>
+#include <cstddef>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 2 > >;
+
+    SCENARIO("BepAlgorithm evaluates from a span of features", "[bp][span]") {
+        GIVEN("a BepAlgorithm with randomly initialized weights") {
+            nn::bp::BepAlgorithm< Perceptron > algorithm(0.1f);
+            const std::array< float, 4 > features{0.1f, 0.7f, -0.3f, 1.f};
+            std::array< Perceptron::Input, 4 > inputs;
+            for(std::size_t i = 0; i < features.size(); ++i) {
+                inputs[i].value[0] = features[i];
+            }
+
+            WHEN("the perceptron is evaluated from the span") {
+                std::array< float, 2 > expected;
+                std::array< float, 2 > actual;
+                algorithm.evaluate(inputs.begin(), inputs.end(), expected.begin());
+                algorithm.evaluate(features, actual);
+
+                THEN("the outputs are the same as for the evaluation from the inputs") {
+                    REQUIRE(actual[0] == Catch::Approx(expected[0]).epsilon(1e-6));
+                    REQUIRE(actual[1] == Catch::Approx(expected[1]).epsilon(1e-6));
+                }
+            }
+        }
+    }
+} // namespace
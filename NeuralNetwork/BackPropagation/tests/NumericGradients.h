@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+namespace nn::bp::test {
+    /// @brief the squared error of the outputs of the prototype, halved.
+    template< typename Algo >
+    double error(Algo& algorithm, const typename Algo::Prototype& prototype) {
+        std::array< double, std::tuple_size_v< std::tuple_element_t< 1, typename Algo::Prototype > > > outputs;
+        const auto& inputs = std::get< 0 >(prototype);
+        algorithm.evaluate(inputs.begin(), inputs.end(), outputs.begin());
+        double sum = 0;
+        for(std::size_t i = 0; i < outputs.size(); ++i) {
+            const double diff = outputs[i] - std::get< 1 >(prototype)[i];
+            sum += diff * diff / 2;
+        }
+        return sum;
+    }
+
+    /// @brief the derivatives of the error by the given parameters,
+    /// calculated by central differences.
+    template< typename Algo, typename Parameters >
+    std::vector< double > numericGradients(Algo& algorithm,
+                                           const typename Algo::Prototype& prototype,
+                                           Parameters& parameters) {
+        constexpr double step = 1e-6;
+        std::vector< double > gradients;
+        for(auto& parameter : parameters) {
+            const double value = parameter;
+            parameter = value + step;
+            const double above = error(algorithm, prototype);
+            parameter = value - step;
+            const double below = error(algorithm, prototype);
+            parameter = value;
+            gradients.push_back((above - below) / (2 * step));
+        }
+        return gradients;
+    }
+} // namespace nn::bp::test
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "NeuralNetwork/ActivationFunction/BiopolarSigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/LogScaleSoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/ReluFunction.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/BackPropagation/BPContext.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+
+#include <MPL/Algorithm.h>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/array.hpp>
+#include <cereal/types/tuple.hpp>
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace nn::exporter {
+
+    namespace detail {
+        /// @brief the name of the function of the generated header which
+        /// applies the activation function to the values of a layer.
+        template< typename Function >
+        struct Activation {
+            static_assert(!std::is_same_v< Function, Function >,
+                          "the activation function can't be exported");
+        };
+
+        /// @brief the generated code uses std::exp and std::tanh whatever
+        /// math policy was used during the training.
+        template< typename Var, typename MathPolicy >
+        struct Activation< SigmoidFunction< Var, MathPolicy > > {
+            static constexpr std::string_view name = "sigmoid";
+        };
+
+        template< typename Var, typename MathPolicy >
+        struct Activation< TanhFunction< Var, MathPolicy > > {
+            static constexpr std::string_view name = "tanh";
+        };
+
+        template< typename Var, typename MathPolicy >
+        struct Activation< BiopolarSigmoidFunction< Var, MathPolicy > > {
+            static constexpr std::string_view name = "tanh";
+        };
+
+        template< typename Var >
+        struct Activation< ReluFunction< Var > > {
+            static constexpr std::string_view name = "relu";
+        };
+
+        template< typename Var >
+        struct Activation< SoftmaxFunction< Var > > {
+            static constexpr std::string_view name = "softmax";
+        };
+
+        template< typename Var >
+        struct Activation< LogScaleSoftmaxFunction< Var > > {
+            static constexpr std::string_view name = "normalize";
+        };
+
+        /// @brief layers whose outputs are activation(W x + b) with one
+        /// activation function for all neurons.
+        template< typename Layer >
+        struct dense : std::false_type {};
+
+        template< typename T >
+        struct dense< nn::detail::NeuralLayer< T > >
+         : std::bool_constant< std::tuple_size_v< typename nn::detail::NeuralLayer< T >::ActivationFunctions > == 1 > {};
+
+        template< typename Internal >
+        struct dense< nn::detail::InputLayer< Internal > > : dense< Internal > {};
+
+        template< typename Layer >
+        using activation_t = Activation< std::tuple_element_t< 0, typename Layer::ActivationFunctions > >;
+
+        template< typename Var >
+        constexpr std::string_view typeName() {
+            if constexpr(std::is_same_v< Var, float >) {
+                return "float";
+            } else {
+                return "double";
+            }
+        }
+
+        /// @brief the shortest literal which is read back as the same value.
+        template< typename Var >
+        std::string literal(Var value) {
+            if(!std::isfinite(value)) {
+                throw std::invalid_argument("only finite weights can be exported");
+            }
+
+            char buffer[64];
+            const auto end = std::to_chars(std::begin(buffer), std::end(buffer), value).ptr;
+            std::string result(buffer, end);
+            if(result.find_first_of(".e") == std::string::npos) {
+                result += ".0";
+            }
+            if constexpr(std::is_same_v< Var, float >) {
+                result += 'f';
+            }
+            return result;
+        }
+
+        template< typename Var, std::size_t rows, std::size_t columns, typename Values >
+        void writeArray(std::ostream& out, std::string_view name, const Values& values) {
+            out << "        inline constexpr std::array< Var, " << rows * columns << " > " << name << "{\n";
+            for(std::size_t row = 0; row < rows; ++row) {
+                out << "         ";
+                for(std::size_t column = 0; column < columns; ++column) {
+                    out << ' ' << literal< Var >(values[row * columns + column]) << ',';
+                }
+                out << '\n';
+            }
+            out << "        };\n";
+        }
+
+        inline void writeKernels(std::ostream& out) {
+            out << R"(        template< std::size_t size, std::size_t inputs >
+        constexpr void dense(const std::array< Var, size * inputs >& weights,
+                             const std::array< Var, size >& biases,
+                             const std::array< Var, inputs >& in,
+                             std::array< Var, size >& out) {
+            for(std::size_t i = 0; i < size; ++i) {
+                Var sum = biases[i];
+                for(std::size_t j = 0; j < inputs; ++j) {
+                    sum += weights[i * inputs + j] * in[j];
+                }
+                out[i] = sum;
+            }
+        }
+
+        template< std::size_t size, std::size_t count >
+        constexpr void sum(const std::array< Var, size * count >& in, std::array< Var, size >& out) {
+            for(std::size_t i = 0; i < size; ++i) {
+                Var sum{};
+                for(std::size_t j = 0; j < count; ++j) {
+                    sum += in[i * count + j];
+                }
+                out[i] = sum;
+            }
+        }
+
+        template< std::size_t size >
+        inline void sigmoid(std::array< Var, size >& values) {
+            for(auto& value : values) {
+                value = Var{1} / (Var{1} + std::exp(-value));
+            }
+        }
+
+        template< std::size_t size >
+        inline void tanh(std::array< Var, size >& values) {
+            for(auto& value : values) {
+                value = std::tanh(value);
+            }
+        }
+
+        template< std::size_t size >
+        constexpr void relu(std::array< Var, size >& values) {
+            for(auto& value : values) {
+                value = value >= Var{0} ? value : Var{0};
+            }
+        }
+
+        template< std::size_t size >
+        inline void softmax(std::array< Var, size >& values) {
+            Var max = values[0];
+            for(auto value : values) {
+                max = value > max ? value : max;
+            }
+            Var total{};
+            for(auto& value : values) {
+                value = std::exp(value - max);
+                total += value;
+            }
+            for(auto& value : values) {
+                value /= total;
+            }
+        }
+
+        template< std::size_t size >
+        constexpr void normalize(std::array< Var, size >& values) {
+            Var total{};
+            for(auto value : values) {
+                total += value;
+            }
+            for(auto& value : values) {
+                value /= total;
+            }
+        }
+)";
+        }
+    } // namespace detail
+
+    /**
+     * Writes a self-contained header which evaluates the perceptron with
+     * the given weights. The weights are constexpr arrays and all shapes
+     * are compile time constants, so the compiler can unroll and vectorize
+     * the loops. The header depends on the standard library only.
+     * Supported are the dense layers (NeuralLayer, MatrixNeuralLayer,
+     * SparseNeuralLayer) with float or double values, sparse layers are
+     * written with their zero weights.
+     * @param out the stream the header is written to.
+     * @param ctx the weights and biases of all layers, one row-major
+     * (neurons x inputs) matrix per layer, e.g. bp::BPContext.
+     * @param name the namespace of the generated code.
+     * @throw std::invalid_argument if a weight is not finite.
+     */
+    template< typename PerceptronType, typename WeightsContext >
+    void writeHeader(std::ostream& out, const WeightsContext& ctx, std::string_view name) {
+        using Var = typename PerceptronType::VarType;
+        using Layers = typename PerceptronType::Layers;
+        using InputLayer = std::tuple_element_t< 0, Layers >;
+        constexpr auto size = PerceptronType::size();
+
+        static_assert(std::is_same_v< Var, float > || std::is_same_v< Var, double >,
+                      "only float and double perceptrons can be exported");
+
+        out << "// generated by nn::exporter::writeHeader, do not edit\n"
+            << "#pragma once\n\n"
+            << "#include <array>\n"
+            << "#include <cmath>\n"
+            << "#include <cstddef>\n\n"
+            << "namespace " << name << " {\n"
+            << "    using Var = " << detail::typeName< Var >() << ";\n\n"
+            << "    inline constexpr std::size_t inputs = " << PerceptronType::inputs() << ";\n"
+            << "    inline constexpr std::size_t features = " << PerceptronType::inputs() * InputLayer::inputs()
+            << ";\n"
+            << "    inline constexpr std::size_t outputs = " << PerceptronType::outputs() << ";\n\n"
+            << "    namespace detail {\n";
+        detail::writeKernels(out);
+
+        utils::for_< size - 1 >([&out, &ctx](auto i) {
+            constexpr auto idx = i.value + 1;
+            using Layer = std::tuple_element_t< idx, Layers >;
+            using Predecessor = std::tuple_element_t< idx - 1, Layers >;
+            static_assert(detail::dense< Layer >::value, "only dense layers can be exported");
+            static_assert(Layer::inputs() == Predecessor::size(), "the layer must be connected to all outputs");
+
+            const auto suffix = std::to_string(idx);
+            out << '\n';
+            detail::writeArray< Var, Layer::size(), Layer::inputs() >(
+             out, "weights" + suffix, std::get< idx >(ctx.weights));
+            detail::writeArray< Var, 1, Layer::size() >(out, "biases" + suffix, std::get< idx >(ctx.biases));
+        });
+
+        static_assert(detail::dense< InputLayer >::value, "only dense layers can be exported");
+        out << "    } // namespace detail\n\n"
+            << "    /// @brief evaluates the outputs for the features of all inputs stored one input after another.\n"
+            << "    inline void evaluate(const std::array< Var, features >& in, std::array< Var, outputs >& out) {\n"
+            << "        std::array< Var, " << InputLayer::size() << " > layer0;\n"
+            << "        detail::sum< " << InputLayer::size() << ", " << InputLayer::inputs() << " >(in, layer0);\n"
+            << "        detail::" << detail::activation_t< InputLayer >::name << "(layer0);\n";
+
+        utils::for_< size - 1 >([&out](auto i) {
+            constexpr auto idx = i.value + 1;
+            using Layer = std::tuple_element_t< idx, Layers >;
+
+            const auto layer = idx + 1 == size ? std::string("out") : "layer" + std::to_string(idx);
+            if(idx + 1 != size) {
+                out << "        std::array< Var, " << Layer::size() << " > " << layer << ";\n";
+            }
+            out << "        detail::dense< " << Layer::size() << ", " << Layer::inputs() << " >(detail::weights"
+                << idx << ", detail::biases" << idx << ", layer" << idx - 1 << ", " << layer << ");\n"
+                << "        detail::" << detail::activation_t< Layer >::name << '(' << layer << ");\n";
+        });
+
+        out << "    }\n"
+            << "} // namespace " << name << '\n';
+    }
+
+    /**
+     * Reads the context stored by the back propagation (see ocr) and writes
+     * the header for it.
+     * @tparam Archive the cereal archive the context was stored with.
+     */
+    template< typename PerceptronType, typename Archive = cereal::JSONInputArchive >
+    void exportHeader(std::istream& model, std::ostream& header, std::string_view name) {
+        using Context = bp::BPContext< typename PerceptronType::VarType, typename PerceptronType::Layers >;
+        // the context of a large perceptron doesn't fit on the stack
+        const auto ctx = std::make_unique< Context >();
+        {
+            Archive archive(model);
+            archive(cereal::make_nvp("context", *ctx));
+        }
+        writeHeader< PerceptronType >(header, *ctx, name);
+    }
+} // namespace nn::exporter
@@ -0,0 +1,45 @@
+#include "NeuralNetwork/Export/tests/ExportedPerceptron.h"
+#include "NeuralNetwork/Export/tests/exported_perceptron.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using namespace nn::exporter::test;
+
+    SCENARIO("Generated header evaluates the perceptron it was exported from", "[export]") {
+        GIVEN("the header generated at build time and the perceptron with the same weights") {
+            STATIC_REQUIRE(std::is_same_v< exported::Var, float >);
+            STATIC_REQUIRE(exported::features == Perceptron::features());
+            STATIC_REQUIRE(exported::outputs == Perceptron::outputs());
+
+            const auto algorithm = std::make_unique< Algo >(0.1f);
+            setWeights(algorithm->context());
+
+            WHEN("both evaluate the same features") {
+                const auto sample = GENERATE(0, 1, 2, 3, 4);
+                std::array< float, exported::features > features;
+                for(std::size_t i = 0; i < features.size(); ++i) {
+                    features[i] = 1.5f * std::sin(static_cast< float >(sample * 17 + i));
+                }
+
+                std::array< float, exported::outputs > expected;
+                std::array< float, exported::outputs > actual;
+                algorithm->evaluate(features, expected);
+                exported::evaluate(features, actual);
+
+                THEN("the outputs are the same") {
+                    for(std::size_t i = 0; i < actual.size(); ++i) {
+                        REQUIRE_THAT(actual[i], Catch::Matchers::WithinAbs(expected[i], 1e-5));
+                    }
+                }
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/ReluFunction.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <MPL/Algorithm.h>
+
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+
+namespace nn::exporter::test {
+    /// @brief the perceptron GenerateHeader exports at build time and
+    /// ExportedHeaderTest compares with the generated header.
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 5, 3 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 8 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::ReluFunction, 6 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 4 > >;
+
+    using Algo = nn::bp::BepAlgorithm< Perceptron >;
+
+    /// @brief the weights the generator and the test both start from.
+    template< typename Context >
+    void setWeights(Context& ctx) {
+        utils::for_< Perceptron::size() - 1 >([&ctx](auto i) {
+            constexpr auto idx = i.value + 1;
+            auto& weights = std::get< idx >(ctx.weights);
+            auto& biases = std::get< idx >(ctx.biases);
+            for(std::size_t w = 0; w < weights.size(); ++w) {
+                weights[w] = 0.8f * std::sin(static_cast< float >(idx * 31 + w));
+            }
+            for(std::size_t b = 0; b < biases.size(); ++b) {
+                biases[b] = 0.1f * std::cos(static_cast< float >(idx * 7 + b));
+            }
+        });
+    }
+} // namespace nn::exporter::test
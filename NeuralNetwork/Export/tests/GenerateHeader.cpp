@@ -0,0 +1,22 @@
+#include "NeuralNetwork/Export/HeaderExporter.h"
+#include "NeuralNetwork/Export/tests/ExportedPerceptron.h"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+/// @brief writes the header of the test perceptron to the given path.
+int main(int argc, char** argv) {
+    using namespace nn::exporter::test;
+    if(argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <header>\n";
+        return 1;
+    }
+
+    const auto algorithm = std::make_unique< Algo >(0.1f);
+    setWeights(algorithm->context());
+
+    std::ofstream header(argv[1]);
+    nn::exporter::writeHeader< Perceptron >(header, algorithm->context(), "exported");
+    return header ? 0 : 1;
+}
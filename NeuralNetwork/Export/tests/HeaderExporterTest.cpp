@@ -0,0 +1,131 @@
+#include "NeuralNetwork/Export/HeaderExporter.h"
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <cereal/archives/binary.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4, 2 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 6 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::SoftmaxFunction, 3 > >;
+
+    using Algo = nn::bp::BepAlgorithm< Perceptron >;
+
+    /// @brief the values of the array with the given name, parsed back
+    /// from the generated header.
+    std::vector< float > parseArray(const std::string& header, const std::string& name) {
+        std::vector< float > values;
+        auto position = header.find("> " + name + "{");
+        REQUIRE(position != std::string::npos);
+        position = header.find('{', position) + 1;
+        const auto end = header.find("};", position);
+        const char* text = header.c_str() + position;
+        while(true) {
+            char* next = nullptr;
+            const float value = std::strtof(text, &next);
+            if(next == text || next > header.c_str() + end) {
+                break;
+            }
+            values.push_back(value);
+            text = next + 2; // the suffix and the comma
+        }
+        return values;
+    }
+
+    SCENARIO("Trained perceptron is exported to a header", "[export]") {
+        GIVEN("the context of a back propagation algorithm") {
+            Algo algorithm(0.1f);
+            auto& ctx = algorithm.context();
+            std::get< 1 >(ctx.weights)[0] = 1.f;
+            std::get< 1 >(ctx.weights)[1] = -0.25f;
+            std::get< 2 >(ctx.biases)[2] = 1e-7f;
+
+            std::ostringstream header;
+            nn::exporter::writeHeader< Perceptron >(header, ctx, "model");
+            const auto text = header.str();
+
+            THEN("the shapes are compile time constants") {
+                REQUIRE(text.find("namespace model {") != std::string::npos);
+                REQUIRE(text.find("using Var = float;") != std::string::npos);
+                REQUIRE(text.find("inline constexpr std::size_t inputs = 4;") != std::string::npos);
+                REQUIRE(text.find("inline constexpr std::size_t features = 8;") != std::string::npos);
+                REQUIRE(text.find("inline constexpr std::size_t outputs = 3;") != std::string::npos);
+            }
+
+            THEN("every layer is evaluated with its activation function") {
+                REQUIRE(text.find("detail::sum< 4, 2 >(in, layer0);") != std::string::npos);
+                REQUIRE(text.find("detail::sigmoid(layer0);") != std::string::npos);
+                REQUIRE(text.find("detail::dense< 6, 4 >(detail::weights1, detail::biases1, layer0, layer1);")
+                        != std::string::npos);
+                REQUIRE(text.find("detail::tanh(layer1);") != std::string::npos);
+                REQUIRE(text.find("detail::dense< 3, 6 >(detail::weights2, detail::biases2, layer1, out);")
+                        != std::string::npos);
+                REQUIRE(text.find("detail::softmax(out);") != std::string::npos);
+            }
+
+            THEN("the weights are written without loss of precision") {
+                REQUIRE(parseArray(text, "weights1")
+                        == std::vector< float >(std::get< 1 >(ctx.weights).begin(), std::get< 1 >(ctx.weights).end()));
+                REQUIRE(parseArray(text, "biases1")
+                        == std::vector< float >(std::get< 1 >(ctx.biases).begin(), std::get< 1 >(ctx.biases).end()));
+                REQUIRE(parseArray(text, "weights2")
+                        == std::vector< float >(std::get< 2 >(ctx.weights).begin(), std::get< 2 >(ctx.weights).end()));
+                REQUIRE(parseArray(text, "biases2")
+                        == std::vector< float >(std::get< 2 >(ctx.biases).begin(), std::get< 2 >(ctx.biases).end()));
+                REQUIRE(text.find(" 1.0f,") != std::string::npos);
+                REQUIRE(text.find(" -0.25f,") != std::string::npos);
+                REQUIRE(text.find(" 1e-07f,") != std::string::npos);
+            }
+
+            WHEN("the context is stored with cereal") {
+                std::stringstream json;
+                {
+                    cereal::JSONOutputArchive archive(json);
+                    archive(cereal::make_nvp("context", ctx));
+                }
+                std::stringstream binary;
+                {
+                    cereal::BinaryOutputArchive archive(binary);
+                    archive(cereal::make_nvp("context", ctx));
+                }
+
+                THEN("the stored context gives the same header") {
+                    std::ostringstream fromJson;
+                    nn::exporter::exportHeader< Perceptron >(json, fromJson, "model");
+                    REQUIRE(fromJson.str() == text);
+
+                    std::ostringstream fromBinary;
+                    nn::exporter::exportHeader< Perceptron, cereal::BinaryInputArchive >(binary, fromBinary, "model");
+                    REQUIRE(fromBinary.str() == text);
+                }
+            }
+
+            WHEN("a weight is not finite") {
+                std::get< 2 >(ctx.weights)[5] = std::numeric_limits< float >::quiet_NaN();
+                THEN("the header is not written") {
+                    std::ostringstream out;
+                    REQUIRE_THROWS_AS(nn::exporter::writeHeader< Perceptron >(out, ctx, "model"),
+                                      std::invalid_argument);
+                }
+            }
+        }
+    }
+} // namespace
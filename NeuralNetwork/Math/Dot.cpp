@@ -0,0 +1,21 @@
+#include "NeuralNetwork/Math/Dot.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL float dot(const float* a, const float* b, std::size_t n) {
+        return detail::dot(a, b, n);
+    }
+
+    NN_MATH_KERNEL double dot(const double* a, const double* b, std::size_t n) {
+        return detail::dot(a, b, n);
+    }
+
+    NN_MATH_KERNEL void axpy(float alpha, const float* x, float* y, std::size_t n) {
+        detail::axpy(alpha, x, y, n);
+    }
+
+    NN_MATH_KERNEL void axpy(double alpha, const double* x, double* y, std::size_t n) {
+        detail::axpy(alpha, x, y, n);
+    }
+} // namespace nn::math
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "NeuralNetwork/Math/Half.h"
+
+#include <cstddef>
+
+namespace nn::math {
+
+    namespace detail {
+        /// @brief number of independent accumulators used by the kernels.
+        /// Covers two AVX-512, four AVX2 or eight SSE registers, which is
+        /// enough to hide the latency of the fused multiply add.
+        template< typename Var >
+        constexpr std::size_t lanes() {
+            return 128 / sizeof(Var) > 0 ? 128 / sizeof(Var) : 1;
+        }
+
+        /// @brief the values of a are converted to Var, so a can be kept in
+        /// a narrower storage type than the one used for the accumulation.
+        template< typename Storage, typename Var >
+        inline Var dot(const Storage* __restrict a, const Var* __restrict b, std::size_t n) {
+            constexpr auto width = lanes< Var >();
+            Var acc[width] = {};
+            std::size_t i = 0;
+            for(; i + width <= n; i += width) {
+                for(std::size_t k = 0; k < width; ++k) {
+                    acc[k] += load< Var >(a[i + k]) * b[i + k];
+                }
+            }
+
+            for(std::size_t k = width / 2; k > 0; k /= 2) {
+                for(std::size_t j = 0; j < k; ++j) {
+                    acc[j] += acc[j + k];
+                }
+            }
+
+            Var result = acc[0];
+            for(; i < n; ++i) {
+                result += load< Var >(a[i]) * b[i];
+            }
+            return result;
+        }
+
+        template< typename Var, typename Storage >
+        inline void axpy(Var alpha, const Storage* __restrict x, Var* __restrict y, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                y[i] += alpha * load< Var >(x[i]);
+            }
+        }
+    } // namespace detail
+
+    /// @brief dot product of two contiguous vectors of the length n.
+    template< typename Var >
+    Var dot(const Var* a, const Var* b, std::size_t n) {
+        return detail::dot(a, b, n);
+    }
+
+    /// @brief y += alpha * x for two contiguous vectors of the length n.
+    template< typename Var >
+    void axpy(Var alpha, const Var* x, Var* y, std::size_t n) {
+        detail::axpy(alpha, x, y, n);
+    }
+
+    /// @brief vectorized kernels, the instruction set (AVX-512, AVX2 + FMA
+    /// or SSE2) is selected at runtime by the cpu the code is running on.
+    float dot(const float* a, const float* b, std::size_t n);
+    double dot(const double* a, const double* b, std::size_t n);
+
+    void axpy(float alpha, const float* x, float* y, std::size_t n);
+    void axpy(double alpha, const double* x, double* y, std::size_t n);
+} // namespace nn::math
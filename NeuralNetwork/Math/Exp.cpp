@@ -0,0 +1,13 @@
+#include "NeuralNetwork/Math/Exp.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL void exp(const float* in, float* out, std::size_t n) {
+        detail::exp(in, out, n);
+    }
+
+    NN_MATH_KERNEL void exp(const double* in, double* out, std::size_t n) {
+        detail::exp(in, out, n);
+    }
+} // namespace nn::math
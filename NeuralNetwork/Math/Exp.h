@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace nn::math {
+
+    namespace detail {
+        /// @brief exp(x) = 2^k * exp(r), where k = round(x / ln(2)) and
+        /// |r| <= ln(2) / 2. exp(r) is approximated by a polynomial and 2^k is
+        /// built directly in the exponent bits. Adding and subtracting the
+        /// shift rounds x / ln(2) to an integer whose value ends up in the
+        /// low bits of the mantissa, so the whole loop vectorizes without
+        /// float to integer conversions.
+        inline void exp(const float* in, float* out, std::size_t n) {
+            constexpr float log2e = 1.44269504088896341f;
+            constexpr float ln2hi = 0.693359375f;
+            constexpr float ln2lo = -2.12194440e-4f;
+            constexpr float shift = 12582912.f; // 1.5 * 2^23
+            // 2^k stays a normal number for these limits
+            constexpr float lo = -87.3365447505531f;
+            constexpr float hi = 88.3762626647949f;
+
+            for(std::size_t i = 0; i < n; ++i) {
+                const float value = in[i];
+                const float x = std::min(std::max(value, lo), hi);
+                const float shifted = x * log2e + shift;
+                const float k = shifted - shift;
+                const float r = x - k * ln2hi - k * ln2lo;
+
+                float p = 1.9875691500e-4f;
+                p = p * r + 1.3981999507e-3f;
+                p = p * r + 8.3334519073e-3f;
+                p = p * r + 4.1665795894e-2f;
+                p = p * r + 1.6666665459e-1f;
+                p = p * r + 5.0000001201e-1f;
+                const float y = p * r * r + r + 1.f;
+
+                const auto exponent = std::bit_cast< std::uint32_t >(shifted) -
+                                      std::bit_cast< std::uint32_t >(shift) + 127u;
+                const float result = y * std::bit_cast< float >(exponent << 23);
+                out[i] = value > hi ? std::numeric_limits< float >::infinity()
+                         : value < lo ? 0.f
+                         : value != value ? value
+                         : result;
+            }
+        }
+
+        inline void exp(const double* in, double* out, std::size_t n) {
+            constexpr double log2e = 1.4426950408889634074;
+            constexpr double ln2hi = 6.93145751953125e-1;
+            constexpr double ln2lo = 1.42860682030941723212e-6;
+            constexpr double shift = 6755399441055744.0; // 1.5 * 2^52
+            constexpr double lo = -708.3964185322641;
+            constexpr double hi = 709.0895657128241;
+
+            for(std::size_t i = 0; i < n; ++i) {
+                const double value = in[i];
+                const double x = std::min(std::max(value, lo), hi);
+                const double shifted = x * log2e + shift;
+                const double k = shifted - shift;
+                const double r = x - k * ln2hi - k * ln2lo;
+
+                // taylor series up to r^13, the error is below the precision
+                // of double for |r| <= ln(2) / 2
+                double p = 1.0 / 6227020800.0;
+                p = p * r + 1.0 / 479001600.0;
+                p = p * r + 1.0 / 39916800.0;
+                p = p * r + 1.0 / 3628800.0;
+                p = p * r + 1.0 / 362880.0;
+                p = p * r + 1.0 / 40320.0;
+                p = p * r + 1.0 / 5040.0;
+                p = p * r + 1.0 / 720.0;
+                p = p * r + 1.0 / 120.0;
+                p = p * r + 1.0 / 24.0;
+                p = p * r + 1.0 / 6.0;
+                p = p * r + 0.5;
+                const double y = p * r * r + r + 1.0;
+
+                const auto exponent = std::bit_cast< std::uint64_t >(shifted) -
+                                      std::bit_cast< std::uint64_t >(shift) + 1023u;
+                const double result = y * std::bit_cast< double >(exponent << 52);
+                out[i] = value > hi ? std::numeric_limits< double >::infinity()
+                         : value < lo ? 0.0
+                         : value != value ? value
+                         : result;
+            }
+        }
+    } // namespace detail
+
+    /// @brief out[i] = exp(in[i]) for n values, in and out may be the same
+    /// array. Types other than float and double provide their own exp found
+    /// by the argument dependent lookup, e.g. FixedPoint.
+    template< typename Var >
+    void exp(const Var* in, Var* out, std::size_t n) {
+        using std::exp;
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = exp(in[i]);
+        }
+    }
+
+    /// @brief vectorized kernels with the relative error of a few ulp. The
+    /// results below the smallest normal number are flushed to zero.
+    void exp(const float* in, float* out, std::size_t n);
+    void exp(const double* in, double* out, std::size_t n);
+} // namespace nn::math
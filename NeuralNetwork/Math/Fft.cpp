@@ -0,0 +1,21 @@
+#include "NeuralNetwork/Math/Fft.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL void fft(const FftPlan< float >& plan,
+                            Direction direction,
+                            std::complex< float >* data,
+                            std::size_t stride,
+                            std::complex< float >* scratch) {
+        detail::fft(plan, direction, data, stride, scratch);
+    }
+
+    NN_MATH_KERNEL void fft(const FftPlan< double >& plan,
+                            Direction direction,
+                            std::complex< double >* data,
+                            std::size_t stride,
+                            std::complex< double >* scratch) {
+        detail::fft(plan, direction, data, stride, scratch);
+    }
+} // namespace nn::math
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+namespace nn::math {
+
+    enum class Direction { Forward, Inverse };
+
+    /// @brief the smallest n' >= n whose prime factors are 2, 3 and 5, the
+    /// sizes the fft supports. Padding to them wastes less than padding to
+    /// a power of two.
+    constexpr std::size_t fftSize(std::size_t n) {
+        for(std::size_t size = std::max< std::size_t >(n, 1);; ++size) {
+            auto rest = size;
+            for(const std::size_t factor : {2, 3, 5}) {
+                while(rest % factor == 0) {
+                    rest /= factor;
+                }
+            }
+            if(rest == 1) {
+                return size;
+            }
+        }
+    }
+
+    /// @brief the radices and the twiddle factors exp(-2 pi i k / n) of a
+    /// transform of n values.
+    template< typename Var >
+    class FftPlan {
+      public:
+        FftPlan() = default;
+
+        /// @param n a size returned by fftSize.
+        explicit FftPlan(std::size_t n)
+         : m_size(n)
+         , m_twiddles(n) {
+            // radix 4 needs no multiplications, it goes first
+            for(const std::size_t radix : {4, 2, 3, 5}) {
+                while(n % radix == 0) {
+                    m_radices.push_back(radix);
+                    n /= radix;
+                }
+            }
+            for(std::size_t k = 0; k < m_size; ++k) {
+                const double angle = -2 * std::numbers::pi * static_cast< double >(k) / static_cast< double >(m_size);
+                m_twiddles[k] = {static_cast< Var >(std::cos(angle)), static_cast< Var >(std::sin(angle))};
+            }
+        }
+
+        std::size_t size() const {
+            return m_size;
+        }
+
+        const std::vector< std::size_t >& radices() const {
+            return m_radices;
+        }
+
+        const std::complex< Var >* twiddles() const {
+            return m_twiddles.data();
+        }
+
+      private:
+        std::size_t m_size = 0;
+        std::vector< std::size_t > m_radices;
+        std::vector< std::complex< Var > > m_twiddles;
+    };
+
+    namespace detail {
+        // std::complex multiplication checks for infinities and doesn't
+        // vectorize, the values here are finite
+        template< typename Var >
+        inline std::complex< Var > multiply(std::complex< Var > a, std::complex< Var > b) {
+            return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+        }
+
+        /// @brief multiplication by -i for the forward and by i for the
+        /// inverse transform.
+        template< typename Var >
+        inline std::complex< Var > rotate(std::complex< Var > a, Direction direction) {
+            return direction == Direction::Forward ? std::complex< Var >{a.imag(), -a.real()}
+                                                   : std::complex< Var >{-a.imag(), a.real()};
+        }
+
+        /**
+         * One decimation in frequency pass of the Stockham algorithm: the
+         * length of the remaining transforms goes from n to n / radix and
+         * their number from stride to stride * radix. The results are
+         * written in order, so no bit reversal is needed.
+         */
+        template< typename Var >
+        inline void fftPass(const FftPlan< Var >& plan,
+                            Direction direction,
+                            std::size_t radix,
+                            std::size_t n,
+                            std::size_t stride,
+                            const std::complex< Var >* __restrict x,
+                            std::complex< Var >* __restrict y) {
+            const auto m = n / radix;
+            const auto* twiddles = plan.twiddles();
+            const auto twiddle = [&](std::size_t k) {
+                const auto w = twiddles[k];
+                return direction == Direction::Forward ? w : std::conj(w);
+            };
+
+            for(std::size_t p = 0; p < m; ++p) {
+                const auto* in = x + stride * p;
+                auto* out = y + stride * radix * p;
+                if(radix == 2) {
+                    const auto w = twiddle(p * stride);
+                    for(std::size_t q = 0; q < stride; ++q) {
+                        const auto a = in[q], b = in[q + stride * m];
+                        out[q] = a + b;
+                        out[q + stride] = multiply(a - b, w);
+                    }
+                } else if(radix == 4) {
+                    const auto w1 = twiddle(p * stride), w2 = twiddle(2 * p * stride), w3 = twiddle(3 * p * stride);
+                    for(std::size_t q = 0; q < stride; ++q) {
+                        const auto a0 = in[q], a1 = in[q + stride * m];
+                        const auto a2 = in[q + 2 * stride * m], a3 = in[q + 3 * stride * m];
+                        const auto s02 = a0 + a2, d02 = a0 - a2;
+                        const auto s13 = a1 + a3, d13 = rotate(a1 - a3, direction);
+                        out[q] = s02 + s13;
+                        out[q + stride] = multiply(d02 + d13, w1);
+                        out[q + 2 * stride] = multiply(s02 - s13, w2);
+                        out[q + 3 * stride] = multiply(d02 - d13, w3);
+                    }
+                } else {
+                    // a direct dft of the radix values, exp(-2 pi i t u / radix)
+                    // is a twiddle of the whole transform
+                    const auto step = plan.size() / radix;
+                    for(std::size_t q = 0; q < stride; ++q) {
+                        for(std::size_t u = 0; u < radix; ++u) {
+                            std::complex< Var > sum = in[q];
+                            for(std::size_t t = 1; t < radix; ++t) {
+                                sum += multiply(in[q + t * stride * m], twiddle(t * u % radix * step));
+                            }
+                            out[q + u * stride] = multiply(sum, twiddle(p * u * stride));
+                        }
+                    }
+                }
+            }
+        }
+
+        template< typename Var >
+        inline void fft(const FftPlan< Var >& plan,
+                        Direction direction,
+                        std::complex< Var >* data,
+                        std::size_t stride,
+                        std::complex< Var >* scratch) {
+            const auto n = plan.size();
+            auto* x = scratch;
+            auto* y = scratch + n;
+            for(std::size_t i = 0; i < n; ++i) {
+                x[i] = data[i * stride];
+            }
+
+            std::size_t length = n, count = 1;
+            for(const auto radix : plan.radices()) {
+                fftPass(plan, direction, radix, length, count, x, y);
+                std::swap(x, y);
+                length /= radix;
+                count *= radix;
+            }
+
+            for(std::size_t i = 0; i < n; ++i) {
+                data[i * stride] = x[i];
+            }
+        }
+    } // namespace detail
+
+    /**
+     * In place discrete Fourier transform of the plan.size() values
+     * data[0], data[stride], ... The inverse transform isn't scaled, it
+     * returns the values multiplied by plan.size().
+     * @param scratch 2 * plan.size() values.
+     */
+    void fft(const FftPlan< float >& plan,
+             Direction direction,
+             std::complex< float >* data,
+             std::size_t stride,
+             std::complex< float >* scratch);
+    void fft(const FftPlan< double >& plan,
+             Direction direction,
+             std::complex< double >* data,
+             std::size_t stride,
+             std::complex< double >* scratch);
+} // namespace nn::math
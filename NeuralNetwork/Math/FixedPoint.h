@@ -0,0 +1,307 @@
+#pragma once
+
+#include "NeuralNetwork/Math/Policy.h"
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace nn::math {
+
+    namespace detail {
+        template< typename Rep >
+        struct wider;
+
+        template<>
+        struct wider< std::int8_t > {
+            using type = std::int16_t;
+        };
+
+        template<>
+        struct wider< std::int16_t > {
+            using type = std::int32_t;
+        };
+
+        template<>
+        struct wider< std::int32_t > {
+            using type = std::int64_t;
+        };
+    } // namespace detail
+
+    /**
+     * Signed Q-format fixed point number with fractionBits bits after the
+     * binary point, usable as Var of the perceptron. Only integer operations
+     * are used, so the results are bit exact on every machine. The results
+     * are rounded to the nearest representable value and saturate at the
+     * limits of Rep instead of wrapping around.
+     */
+    template< int fractionBits = 16, typename Rep = std::int32_t >
+    class FixedPoint {
+        using Wide = typename detail::wider< Rep >::type;
+
+        static_assert(std::is_signed_v< Rep >, "the representation must be a signed integer");
+        static_assert(fractionBits > 0 && fractionBits < std::numeric_limits< Rep >::digits - 1,
+                      "at least one integer bit is needed");
+
+        static constexpr Wide one = Wide{1} << fractionBits;
+
+      public:
+        static constexpr int fraction = fractionBits;
+
+        constexpr FixedPoint() = default;
+
+        template< typename T >
+            requires std::is_arithmetic_v< T >
+        constexpr FixedPoint(T value)
+         : m_raw(fromArithmetic(value)) {
+        }
+
+        static constexpr FixedPoint fromRaw(Rep raw) {
+            FixedPoint result;
+            result.m_raw = raw;
+            return result;
+        }
+
+        constexpr Rep raw() const {
+            return m_raw;
+        }
+
+        static constexpr FixedPoint max() {
+            return fromRaw(std::numeric_limits< Rep >::max());
+        }
+
+        static constexpr FixedPoint lowest() {
+            return fromRaw(std::numeric_limits< Rep >::min());
+        }
+
+        /// @brief the smallest positive value.
+        static constexpr FixedPoint epsilon() {
+            return fromRaw(1);
+        }
+
+        /// @brief integral conversions truncate towards zero.
+        template< typename T >
+            requires std::is_arithmetic_v< T >
+        explicit constexpr operator T() const {
+            if constexpr(std::is_floating_point_v< T >) {
+                return static_cast< T >(m_raw) / static_cast< T >(one);
+            } else {
+                return static_cast< T >(m_raw / one);
+            }
+        }
+
+        constexpr FixedPoint operator-() const {
+            return fromRaw(saturate(-Wide{m_raw}));
+        }
+
+        constexpr FixedPoint operator+() const {
+            return *this;
+        }
+
+        constexpr FixedPoint& operator+=(FixedPoint other) {
+            m_raw = saturate(Wide{m_raw} + other.m_raw);
+            return *this;
+        }
+
+        constexpr FixedPoint& operator-=(FixedPoint other) {
+            m_raw = saturate(Wide{m_raw} - other.m_raw);
+            return *this;
+        }
+
+        constexpr FixedPoint& operator*=(FixedPoint other) {
+            const Wide product = Wide{m_raw} * other.m_raw;
+            m_raw = saturate((product + one / 2) >> fractionBits);
+            return *this;
+        }
+
+        /// @brief division by zero saturates with the sign of the dividend.
+        constexpr FixedPoint& operator/=(FixedPoint other) {
+            if(other.m_raw == 0) {
+                m_raw = m_raw < 0 ? std::numeric_limits< Rep >::min()
+                                  : std::numeric_limits< Rep >::max();
+                return *this;
+            }
+            const Wide dividend = Wide{m_raw} * one;
+            const Wide divisor = other.m_raw;
+            const Wide half = (divisor < 0 ? -divisor : divisor) / 2;
+            m_raw = saturate((dividend < 0 ? dividend - half : dividend + half) / divisor);
+            return *this;
+        }
+
+        friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b) {
+            return a += b;
+        }
+
+        friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b) {
+            return a -= b;
+        }
+
+        friend constexpr FixedPoint operator*(FixedPoint a, FixedPoint b) {
+            return a *= b;
+        }
+
+        friend constexpr FixedPoint operator/(FixedPoint a, FixedPoint b) {
+            return a /= b;
+        }
+
+        friend constexpr bool operator==(FixedPoint a, FixedPoint b) = default;
+        friend constexpr auto operator<=>(FixedPoint a, FixedPoint b) = default;
+
+      private:
+        static constexpr Rep saturate(Wide value) {
+            constexpr Wide lo = std::numeric_limits< Rep >::min();
+            constexpr Wide hi = std::numeric_limits< Rep >::max();
+            return static_cast< Rep >(value < lo ? lo : value > hi ? hi : value);
+        }
+
+        template< typename T >
+        static constexpr Rep fromArithmetic(T value) {
+            if constexpr(std::is_floating_point_v< T >) {
+                const auto scaled = static_cast< double >(value) * static_cast< double >(one);
+                if(scaled != scaled) {
+                    return 0;
+                }
+                if(scaled >= static_cast< double >(std::numeric_limits< Rep >::max())) {
+                    return std::numeric_limits< Rep >::max();
+                }
+                if(scaled <= static_cast< double >(std::numeric_limits< Rep >::min())) {
+                    return std::numeric_limits< Rep >::min();
+                }
+                return static_cast< Rep >(static_cast< Wide >(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+            } else {
+                constexpr auto limit = std::numeric_limits< Rep >::max() / one;
+                if(std::cmp_less(value, -limit - 1)) {
+                    return std::numeric_limits< Rep >::min();
+                }
+                if(std::cmp_greater(value, limit)) {
+                    return std::numeric_limits< Rep >::max();
+                }
+                return static_cast< Rep >(static_cast< Wide >(value) * one);
+            }
+        }
+
+        Rep m_raw{};
+    };
+
+    /// @brief exp(x) = 2^k * 2^r with the integer k and r in [0, 1). 2^r is
+    /// a polynomial evaluated in fixed point, 2^k is a shift. Saturates at
+    /// the largest representable value.
+    template< int fractionBits, typename Rep >
+    constexpr FixedPoint< fractionBits, Rep > exp(FixedPoint< fractionBits, Rep > x) {
+        using Fixed = FixedPoint< fractionBits, Rep >;
+        using Wide = typename detail::wider< Rep >::type;
+        constexpr int digits = std::numeric_limits< Rep >::digits;
+
+        const auto y = x * Fixed(1.4426950408889634);
+        const Rep k = y.raw() >> fractionBits;
+        const auto r = Fixed::fromRaw(static_cast< Rep >(y.raw() - (Wide{k} << fractionBits)));
+
+        // taylor series of exp(r * ln(2)), the error is below 2e-6
+        auto p = Fixed(1.525273380405984e-5);
+        p = p * r + Fixed(1.540353039338161e-4);
+        p = p * r + Fixed(1.333355814642844e-3);
+        p = p * r + Fixed(9.618129107628477e-3);
+        p = p * r + Fixed(5.550410866482158e-2);
+        p = p * r + Fixed(2.402265069591007e-1);
+        p = p * r + Fixed(6.931471805599453e-1);
+        p = p * r + Fixed(1);
+
+        if(k >= 0) {
+            if(k >= digits - fractionBits) {
+                return Fixed::max();
+            }
+            const Wide shifted = Wide{p.raw()} << k;
+            return shifted > std::numeric_limits< Rep >::max() ? Fixed::max()
+                                                               : Fixed::fromRaw(static_cast< Rep >(shifted));
+        }
+        if(-k > digits) {
+            return Fixed{};
+        }
+        const Wide half = Wide{1} << (-k - 1);
+        return Fixed::fromRaw(static_cast< Rep >((Wide{p.raw()} + half) >> -k));
+    }
+
+    /**
+     * Sigmoid and tanh of fixed point numbers with integer operations only.
+     * The sigmoid is sampled on [-range, range] into a table of raw values
+     * at compile time and linearly interpolated, the arguments outside of
+     * the range are clamped. tanh(x) = 2 * sigmoid(2 * x) - 1. With 16
+     * fraction bits the absolute error is below 3e-5 for sigmoid and 5e-5
+     * for tanh. The activation functions use it for FixedPoint whatever
+     * math policy they are given.
+     */
+    template< int fractionBits, typename Rep >
+    struct IntegerLookupTable {
+        using Fixed = FixedPoint< fractionBits, Rep >;
+
+        static constexpr Fixed sigmoid(Fixed x) {
+            return Fixed::fromRaw(static_cast< Rep >(sigmoid(Wide{x.raw()})));
+        }
+
+        static constexpr Fixed tanh(Fixed x) {
+            return Fixed::fromRaw(static_cast< Rep >(2 * sigmoid(2 * Wide{x.raw()}) - one));
+        }
+
+        static void sigmoid(const Fixed* in, Fixed* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = sigmoid(in[i]);
+            }
+        }
+
+        static void tanh(const Fixed* in, Fixed* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = tanh(in[i]);
+            }
+        }
+
+      private:
+        using Wide = typename detail::wider< Rep >::type;
+
+        static constexpr Wide one = Wide{1} << fractionBits;
+        static constexpr int range = 16;
+        static constexpr int rangeBits = 5; // 2 * range = 2^rangeBits
+        static constexpr int segmentBits = fractionBits + rangeBits < 10 ? fractionBits + rangeBits : 10;
+        static constexpr std::size_t segments = std::size_t{1} << segmentBits;
+        // the raw values of an argument in one segment
+        static constexpr int shift = fractionBits + rangeBits - segmentBits;
+
+        /// @brief the raw sigmoid of a raw argument.
+        static constexpr Wide sigmoid(Wide raw) {
+            constexpr Wide width = Wide{2 * range} << fractionBits;
+            Wide offset = raw + (Wide{range} << fractionBits);
+            offset = offset < 0 ? 0 : offset > width ? width : offset;
+            const auto index = static_cast< std::size_t >(offset >> shift);
+            if constexpr(shift == 0) {
+                return table[index];
+            } else {
+                if(index == segments) {
+                    return table[segments];
+                }
+                const Wide fraction = offset - (static_cast< Wide >(index) << shift);
+                const Wide step = Wide{table[index + 1]} - table[index];
+                return table[index] + ((step * fraction + (Wide{1} << (shift - 1))) >> shift);
+            }
+        }
+
+        static constexpr std::array< Rep, segments + 1 > generate() {
+            std::array< Rep, segments + 1 > values{};
+            for(std::size_t i = 0; i <= segments; ++i) {
+                const double x = -range + 2. * range * static_cast< double >(i) / segments;
+                const double value = static_cast< double >(one) / (1. + detail::constexprExp(-x));
+                values[i] = static_cast< Rep >(value + 0.5);
+            }
+            return values;
+        }
+
+        static constexpr std::array< Rep, segments + 1 > table = generate();
+    };
+
+    template< typename MathPolicy, int fractionBits, typename Rep >
+    struct select_policy< MathPolicy, FixedPoint< fractionBits, Rep > > {
+        using type = IntegerLookupTable< fractionBits, Rep >;
+    };
+} // namespace nn::math
@@ -0,0 +1,81 @@
+#include "NeuralNetwork/Math/Gemm.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+                             float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+                             float beta, float* c, std::size_t ldc) {
+        detail::gemm(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    NN_MATH_KERNEL void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+                             double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+                             double beta, double* c, std::size_t ldc) {
+        detail::gemm(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    NN_MATH_KERNEL void gemm(Transpose transA, std::size_t m, float alpha, const float* a, std::size_t lda,
+                             const PackedMatrix< float >& b, float beta, float* c, std::size_t ldc) {
+        detail::gemm(transA, m, b.cols(), b.rows(), alpha, a, lda,
+                     [&b](std::size_t row, std::size_t col, std::size_t, std::size_t) {
+                         return b.block(row, col);
+                     },
+                     beta, c, ldc);
+    }
+
+    NN_MATH_KERNEL void gemm(Transpose transA, std::size_t m, double alpha, const double* a, std::size_t lda,
+                             const PackedMatrix< double >& b, double beta, double* c, std::size_t ldc) {
+        detail::gemm(transA, m, b.cols(), b.rows(), alpha, a, lda,
+                     [&b](std::size_t row, std::size_t col, std::size_t, std::size_t) {
+                         return b.block(row, col);
+                     },
+                     beta, c, ldc);
+    }
+
+    NN_MATH_KERNEL void gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const float* a,
+                             std::size_t lda, const float* x, float beta, float* y) {
+        detail::gemv(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    NN_MATH_KERNEL void gemv(Transpose trans, std::size_t m, std::size_t n, double alpha, const double* a,
+                             std::size_t lda, const double* x, double beta, double* y) {
+        detail::gemv(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    NN_MATH_KERNEL void ger(std::size_t m, std::size_t n, float alpha, const float* x, const float* y,
+                            float* a, std::size_t lda) {
+        detail::ger(m, n, alpha, x, y, a, lda);
+    }
+
+    NN_MATH_KERNEL void ger(std::size_t m, std::size_t n, double alpha, const double* x, const double* y,
+                            double* a, std::size_t lda) {
+        detail::ger(m, n, alpha, x, y, a, lda);
+    }
+
+#ifdef NN_MATH_HAS_FLOAT16
+    NN_MATH_KERNEL void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+                             float alpha, const float* a, std::size_t lda, const float16* b, std::size_t ldb,
+                             float beta, float* c, std::size_t ldc) {
+        detail::gemm(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+#endif
+
+    NN_MATH_KERNEL void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+                             float alpha, const float* a, std::size_t lda, const bfloat16* b, std::size_t ldb,
+                             float beta, float* c, std::size_t ldc) {
+        detail::gemm(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+#ifdef NN_MATH_HAS_FLOAT16
+    NN_MATH_KERNEL void gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const float16* a,
+                             std::size_t lda, const float* x, float beta, float* y) {
+        detail::gemv(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+#endif
+
+    NN_MATH_KERNEL void gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const bfloat16* a,
+                             std::size_t lda, const float* x, float beta, float* y) {
+        detail::gemv(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+} // namespace nn::math
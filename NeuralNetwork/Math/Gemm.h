@@ -0,0 +1,415 @@
+#pragma once
+
+#include "NeuralNetwork/Math/Dot.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace nn::math {
+
+    /// @brief whether a row-major matrix argument is used as it is or
+    /// transposed.
+    enum class Transpose { No, Yes };
+
+    namespace detail {
+        /// @brief register and cache blocking of the gemm kernel. The mr x nr
+        /// block of C is kept in registers (12 AVX2 or 6 AVX-512 registers),
+        /// a kc x nr panel of B stays in L1, a mc x kc block of A in L2 and a
+        /// kc x nc block of B in L3.
+        template< typename Var >
+        struct Blocking {
+            static constexpr std::size_t mr = 6;
+            static constexpr std::size_t nr = 64 / sizeof(Var) > 0 ? 64 / sizeof(Var) : 1;
+            static constexpr std::size_t kc = 256;
+            static constexpr std::size_t mc = 20 * mr;
+            static constexpr std::size_t nc = 256 * nr;
+        };
+
+        inline std::size_t roundUp(std::size_t value, std::size_t multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        template< typename T >
+        inline const T& element(const T* a, std::size_t lda, Transpose trans, std::size_t i, std::size_t j) {
+            return trans == Transpose::No ? a[i * lda + j] : a[j * lda + i];
+        }
+
+        /// @brief copies kc x nc block of op(B) to panels of nr columns, the
+        /// nr values of one row of a panel are contiguous. The last panel is
+        /// padded with zeros. B may be stored in a narrower type, the panels
+        /// are always converted to Var.
+        template< typename Var, typename Storage >
+        inline void packB(Transpose trans,
+                          const Storage* b,
+                          std::size_t ldb,
+                          std::size_t row,
+                          std::size_t col,
+                          std::size_t kc,
+                          std::size_t nc,
+                          Var* out) {
+            constexpr auto nr = Blocking< Var >::nr;
+            for(std::size_t jr = 0; jr < nc; jr += nr) {
+                const auto width = std::min(nr, nc - jr);
+                for(std::size_t p = 0; p < kc; ++p) {
+                    for(std::size_t j = 0; j < nr; ++j) {
+                        *out++ = j < width ? load< Var >(element(b, ldb, trans, row + p, col + jr + j))
+                                           : Var{};
+                    }
+                }
+            }
+        }
+
+        /// @brief copies mc x kc block of op(A) to panels of mr rows, the mr
+        /// values of one column of a panel are contiguous.
+        template< typename Var >
+        inline void packA(Transpose trans,
+                          const Var* a,
+                          std::size_t lda,
+                          std::size_t row,
+                          std::size_t col,
+                          std::size_t mc,
+                          std::size_t kc,
+                          Var* out) {
+            constexpr auto mr = Blocking< Var >::mr;
+            for(std::size_t ir = 0; ir < mc; ir += mr) {
+                const auto height = std::min(mr, mc - ir);
+                for(std::size_t p = 0; p < kc; ++p) {
+                    for(std::size_t i = 0; i < mr; ++i) {
+                        *out++ = i < height ? element(a, lda, trans, row + ir + i, col + p) : Var{};
+                    }
+                }
+            }
+        }
+
+        /// @brief C += alpha * A * B for one mr x nr block of C, where A and B
+        /// are packed panels. The accumulators are stored with fixed bounds
+        /// only, so the compiler keeps them in registers, partial blocks at
+        /// the edges of C go through a temporary tile.
+        template< typename Var >
+        inline void microKernel(std::size_t kc,
+                                Var alpha,
+                                const Var* __restrict a,
+                                const Var* __restrict b,
+                                Var* c,
+                                std::size_t ldc,
+                                std::size_t height,
+                                std::size_t width) {
+            constexpr auto mr = Blocking< Var >::mr;
+            constexpr auto nr = Blocking< Var >::nr;
+            Var acc[mr][nr] = {};
+            for(std::size_t p = 0; p < kc; ++p) {
+                const Var* row = b + p * nr;
+                // unrolling the rows lets the compiler vectorize the columns
+                // instead of the rows of the block
+#pragma GCC unroll 8
+                for(std::size_t i = 0; i < mr; ++i) {
+                    const Var value = a[p * mr + i];
+                    for(std::size_t j = 0; j < nr; ++j) {
+                        acc[i][j] += value * row[j];
+                    }
+                }
+            }
+
+            if(height == mr && width == nr) {
+                for(std::size_t i = 0; i < mr; ++i) {
+                    for(std::size_t j = 0; j < nr; ++j) {
+                        c[i * ldc + j] += alpha * acc[i][j];
+                    }
+                }
+            } else {
+                Var tile[mr][nr];
+                for(std::size_t i = 0; i < mr; ++i) {
+                    for(std::size_t j = 0; j < nr; ++j) {
+                        tile[i][j] = acc[i][j];
+                    }
+                }
+                for(std::size_t i = 0; i < height; ++i) {
+                    for(std::size_t j = 0; j < width; ++j) {
+                        c[i * ldc + j] += alpha * tile[i][j];
+                    }
+                }
+            }
+        }
+
+        template< typename Var >
+        inline void scale(std::size_t m, std::size_t n, Var beta, Var* c, std::size_t ldc) {
+            if(beta == Var{1}) {
+                return;
+            }
+            for(std::size_t i = 0; i < m; ++i) {
+                for(std::size_t j = 0; j < n; ++j) {
+                    c[i * ldc + j] = beta == Var{} ? Var{} : beta * c[i * ldc + j];
+                }
+            }
+        }
+
+        template< typename Var >
+        inline std::vector< Var >& workspace() {
+            thread_local std::vector< Var > buffer;
+            return buffer;
+        }
+
+        /// @brief blocked gemm loop. packedB(row, col, kc, nc) returns the
+        /// packed kc x nc block of op(B) starting at (row, col).
+        template< typename Var, typename PackedB >
+        inline void gemm(Transpose transA,
+                         std::size_t m,
+                         std::size_t n,
+                         std::size_t k,
+                         Var alpha,
+                         const Var* a,
+                         std::size_t lda,
+                         PackedB packedB,
+                         Var beta,
+                         Var* c,
+                         std::size_t ldc) {
+            using B = Blocking< Var >;
+            scale(m, n, beta, c, ldc);
+            if(m == 0 || n == 0 || k == 0 || alpha == Var{}) {
+                return;
+            }
+
+            auto& packedA = workspace< Var >();
+            packedA.resize(B::mc * B::kc);
+
+            for(std::size_t jc = 0; jc < n; jc += B::nc) {
+                const auto nc = std::min(B::nc, n - jc);
+                for(std::size_t pc = 0; pc < k; pc += B::kc) {
+                    const auto kc = std::min(B::kc, k - pc);
+                    const Var* b = packedB(pc, jc, kc, nc);
+                    for(std::size_t ic = 0; ic < m; ic += B::mc) {
+                        const auto mc = std::min(B::mc, m - ic);
+                        packA(transA, a, lda, ic, pc, mc, kc, packedA.data());
+                        for(std::size_t jr = 0; jr < nc; jr += B::nr) {
+                            for(std::size_t ir = 0; ir < mc; ir += B::mr) {
+                                microKernel(kc,
+                                            alpha,
+                                            packedA.data() + ir * kc,
+                                            b + jr * kc,
+                                            c + (ic + ir) * ldc + jc + jr,
+                                            ldc,
+                                            std::min(B::mr, mc - ir),
+                                            std::min(B::nr, nc - jr));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template< typename Var, typename Storage >
+        inline void gemm(Transpose transA,
+                         Transpose transB,
+                         std::size_t m,
+                         std::size_t n,
+                         std::size_t k,
+                         Var alpha,
+                         const Var* a,
+                         std::size_t lda,
+                         const Storage* b,
+                         std::size_t ldb,
+                         Var beta,
+                         Var* c,
+                         std::size_t ldc) {
+            using B = Blocking< Var >;
+            thread_local std::vector< Var > packed;
+            packed.resize(B::kc * roundUp(std::min(B::nc, n), B::nr));
+            gemm(transA, m, n, k, alpha, a, lda,
+                 [&](std::size_t row, std::size_t col, std::size_t kc, std::size_t nc) {
+                     packB(transB, b, ldb, row, col, kc, nc, packed.data());
+                     return static_cast< const Var* >(packed.data());
+                 },
+                 beta, c, ldc);
+        }
+
+        template< typename Var, typename Storage >
+        inline void gemv(Transpose trans,
+                         std::size_t m,
+                         std::size_t n,
+                         Var alpha,
+                         const Storage* a,
+                         std::size_t lda,
+                         const Var* x,
+                         Var beta,
+                         Var* y) {
+            if(trans == Transpose::No) {
+                for(std::size_t i = 0; i < m; ++i) {
+                    const Var value = alpha * detail::dot(a + i * lda, x, n);
+                    y[i] = beta == Var{} ? value : beta * y[i] + value;
+                }
+            } else {
+                scale(std::size_t{1}, n, beta, y, n);
+                for(std::size_t i = 0; i < m; ++i) {
+                    detail::axpy(Var{alpha * x[i]}, a + i * lda, y, n);
+                }
+            }
+        }
+
+        template< typename Var >
+        inline void ger(std::size_t m,
+                        std::size_t n,
+                        Var alpha,
+                        const Var* x,
+                        const Var* y,
+                        Var* a,
+                        std::size_t lda) {
+            for(std::size_t i = 0; i < m; ++i) {
+                axpy(Var{alpha * x[i]}, y, a + i * lda, n);
+            }
+        }
+    } // namespace detail
+
+    /// @brief op(B) of the gemm packed once into the layout of the kernel.
+    /// Used for matrices which are multiplied many times, e.g. the weights of
+    /// a layer during the inference.
+    template< typename Var >
+    class PackedMatrix {
+        using B = detail::Blocking< Var >;
+
+      public:
+        PackedMatrix() = default;
+
+        /// @brief packs op(B) of the size k x n.
+        PackedMatrix(Transpose trans, std::size_t k, std::size_t n, const Var* b, std::size_t ldb)
+         : m_rows(k)
+         , m_cols(n) {
+            for(std::size_t jc = 0; jc < n; jc += B::nc) {
+                const auto nc = std::min(B::nc, n - jc);
+                for(std::size_t pc = 0; pc < k; pc += B::kc) {
+                    const auto kc = std::min(B::kc, k - pc);
+                    const auto offset = m_data.size();
+                    m_data.resize(offset + kc * detail::roundUp(nc, B::nr));
+                    detail::packB(trans, b, ldb, pc, jc, kc, nc, m_data.data() + offset);
+                }
+            }
+        }
+
+        std::size_t rows() const {
+            return m_rows;
+        }
+
+        std::size_t cols() const {
+            return m_cols;
+        }
+
+        /// @brief packed kc x nc block of op(B) starting at (row, col).
+        const Var* block(std::size_t row, std::size_t col) const {
+            const auto nc = std::min(B::nc, m_cols - col);
+            return m_data.data() + col * m_rows + row * detail::roundUp(nc, B::nr);
+        }
+
+      private:
+        std::size_t m_rows{};
+        std::size_t m_cols{};
+        std::vector< Var > m_data;
+    };
+
+    /// @brief C = alpha * op(A) * op(B) + beta * C, where op(A) is m x k,
+    /// op(B) is k x n and all matrices are stored row by row with the given
+    /// leading dimensions.
+    template< typename Var >
+    void gemm(Transpose transA,
+              Transpose transB,
+              std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              Var alpha,
+              const Var* a,
+              std::size_t lda,
+              const Var* b,
+              std::size_t ldb,
+              Var beta,
+              Var* c,
+              std::size_t ldc) {
+        detail::gemm(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    /// @brief C = alpha * op(A) * B + beta * C with a prepacked B.
+    template< typename Var >
+    void gemm(Transpose transA,
+              std::size_t m,
+              Var alpha,
+              const Var* a,
+              std::size_t lda,
+              const PackedMatrix< Var >& b,
+              Var beta,
+              Var* c,
+              std::size_t ldc) {
+        detail::gemm(transA, m, b.cols(), b.rows(), alpha, a, lda,
+                     [&b](std::size_t row, std::size_t col, std::size_t, std::size_t) {
+                         return b.block(row, col);
+                     },
+                     beta, c, ldc);
+    }
+
+    /// @brief y = alpha * op(A) * x + beta * y, where A is m x n.
+    template< typename Var >
+    void gemv(Transpose trans,
+              std::size_t m,
+              std::size_t n,
+              Var alpha,
+              const Var* a,
+              std::size_t lda,
+              const Var* x,
+              Var beta,
+              Var* y) {
+        detail::gemv(trans, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    /// @brief A += alpha * x * y^T, where A is m x n.
+    template< typename Var >
+    void ger(std::size_t m,
+             std::size_t n,
+             Var alpha,
+             const Var* x,
+             const Var* y,
+             Var* a,
+             std::size_t lda) {
+        detail::ger(m, n, alpha, x, y, a, lda);
+    }
+
+    /// @brief vectorized kernels, the instruction set is selected at
+    /// runtime by the cpu the code is running on.
+    void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc);
+    void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc);
+
+    void gemm(Transpose transA, std::size_t m, float alpha, const float* a, std::size_t lda,
+              const PackedMatrix< float >& b, float beta, float* c, std::size_t ldc);
+    void gemm(Transpose transA, std::size_t m, double alpha, const double* a, std::size_t lda,
+              const PackedMatrix< double >& b, double beta, double* c, std::size_t ldc);
+
+    void gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const float* a,
+              std::size_t lda, const float* x, float beta, float* y);
+    void gemv(Transpose trans, std::size_t m, std::size_t n, double alpha, const double* a,
+              std::size_t lda, const double* x, double beta, double* y);
+
+    void ger(std::size_t m, std::size_t n, float alpha, const float* x, const float* y,
+             float* a, std::size_t lda);
+
+    /// @brief mixed precision kernels, the matrix is stored in half
+    /// precision and converted to float on the fly, all the arithmetic is
+    /// done in float. Halves the memory traffic of the bandwidth bound
+    /// products.
+#ifdef NN_MATH_HAS_FLOAT16
+    void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float16* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc);
+#endif
+    void gemm(Transpose transA, Transpose transB, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const bfloat16* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc);
+
+#ifdef NN_MATH_HAS_FLOAT16
+    void gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const float16* a,
+              std::size_t lda, const float* x, float beta, float* y);
+#endif
+    void gemv(Transpose trans, std::size_t m, std::size_t n, float alpha, const bfloat16* a,
+              std::size_t lda, const float* x, float beta, float* y);
+    void ger(std::size_t m, std::size_t n, double alpha, const double* x, const double* y,
+             double* a, std::size_t lda);
+} // namespace nn::math
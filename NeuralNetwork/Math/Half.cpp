@@ -0,0 +1,34 @@
+#include "NeuralNetwork/Math/Half.h"
+#include "NeuralNetwork/Math/Dot.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+#ifdef NN_MATH_HAS_FLOAT16
+    NN_MATH_KERNEL void convert(const float* in, float16* out, std::size_t n) {
+        detail::convert(in, out, n);
+    }
+
+    NN_MATH_KERNEL void convert(const float16* in, float* out, std::size_t n) {
+        detail::convert(in, out, n);
+    }
+#endif
+
+    NN_MATH_KERNEL void convert(const float* in, bfloat16* out, std::size_t n) {
+        detail::convert(in, out, n);
+    }
+
+    NN_MATH_KERNEL void convert(const bfloat16* in, float* out, std::size_t n) {
+        detail::convert(in, out, n);
+    }
+
+#ifdef NN_MATH_HAS_FLOAT16
+    NN_MATH_KERNEL float dot(const float16* a, const float* b, std::size_t n) {
+        return detail::dot(a, b, n);
+    }
+#endif
+
+    NN_MATH_KERNEL float dot(const bfloat16* a, const float* b, std::size_t n) {
+        return detail::dot(a, b, n);
+    }
+} // namespace nn::math
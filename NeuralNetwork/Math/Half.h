@@ -0,0 +1,111 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// _Float16 is a compiler extension (not available with MSVC or for older
+// x86 targets), float16 and its kernels are declared only where it exists.
+#if defined(__FLT16_MANT_DIG__)
+#define NN_MATH_HAS_FLOAT16 1
+#endif
+
+namespace nn::math {
+
+#ifdef NN_MATH_HAS_FLOAT16
+    /// @brief IEEE 754 half precision. Used as a storage type only, the
+    /// kernels convert the values to float before any arithmetic.
+    using float16 = _Float16;
+#endif
+
+    /// @brief upper half of a float (8 bit exponent, 7 bit mantissa). Has
+    /// the range of float with the precision of about 3 decimal digits.
+    struct bfloat16 {
+        bfloat16() = default;
+
+        /// @brief rounds to the nearest even value, keeps NaN a NaN.
+        constexpr bfloat16(float value)
+         : bits(fromFloat(value)) {
+        }
+
+        constexpr operator float() const {
+            return std::bit_cast< float >(static_cast< std::uint32_t >(bits) << 16);
+        }
+
+        std::uint16_t bits;
+
+      private:
+        static constexpr std::uint16_t fromFloat(float value) {
+            const auto word = std::bit_cast< std::uint32_t >(value);
+            const auto rounded = word + 0x7fffu + ((word >> 16) & 1u);
+            const auto nan = static_cast< std::uint32_t >((word & 0x7fffffffu) > 0x7f800000u);
+            return static_cast< std::uint16_t >(((word >> 16) | (nan << 6)) * nan + (rounded >> 16) * (1u - nan));
+        }
+    };
+
+#ifdef NN_MATH_HAS_FLOAT16
+    /// @brief the default half precision storage type.
+    using half = float16;
+#else
+    using half = bfloat16;
+#endif
+
+    namespace detail {
+#ifdef NN_MATH_HAS_FLOAT16
+        /// @brief half to float with integer operations only. Unlike the
+        /// conversion of the compiler it vectorizes without F16C or
+        /// AVX512-FP16. Normal numbers are rebiased by a multiplication,
+        /// subnormal ones are built as a float with a known exponent.
+        inline float widen(float16 value) {
+            const auto word = static_cast< std::uint32_t >(std::bit_cast< std::uint16_t >(value)) << 16;
+            const auto sign = word & 0x80000000u;
+            const auto twice = word + word;
+
+            const auto normal = std::bit_cast< float >((twice >> 4) + (0xe0u << 23)) * 0x1.0p-112f;
+            const auto subnormal = std::bit_cast< float >((twice >> 17) | (126u << 23)) - 0.5f;
+            const auto magnitude = twice < (1u << 27) ? std::bit_cast< std::uint32_t >(subnormal)
+                                                     : std::bit_cast< std::uint32_t >(normal);
+            return std::bit_cast< float >(sign | magnitude);
+        }
+#endif
+
+        /// @brief converts a stored value to the type of the calculations.
+        template< typename Var, typename Storage >
+        inline Var load(const Storage& value) {
+#ifdef NN_MATH_HAS_FLOAT16
+            if constexpr(std::is_same_v< Storage, float16 > && std::is_same_v< Var, float >) {
+                return widen(value);
+            }
+#endif
+            return static_cast< Var >(value);
+        }
+
+        template< typename From, typename To >
+        inline void convert(const From* __restrict in, To* __restrict out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = load< To >(in[i]);
+            }
+        }
+    } // namespace detail
+
+    /// @brief out[i] = in[i] converted to the type of out.
+    template< typename From, typename To >
+    void convert(const From* in, To* out, std::size_t n) {
+        detail::convert(in, out, n);
+    }
+
+#ifdef NN_MATH_HAS_FLOAT16
+    void convert(const float* in, float16* out, std::size_t n);
+    void convert(const float16* in, float* out, std::size_t n);
+#endif
+    void convert(const float* in, bfloat16* out, std::size_t n);
+    void convert(const bfloat16* in, float* out, std::size_t n);
+
+    /// @brief dot product of half precision weights and float values,
+    /// accumulated in float.
+#ifdef NN_MATH_HAS_FLOAT16
+    float dot(const float16* a, const float* b, std::size_t n);
+#endif
+    float dot(const bfloat16* a, const float* b, std::size_t n);
+} // namespace nn::math
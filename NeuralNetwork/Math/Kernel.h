@@ -0,0 +1,10 @@
+#pragma once
+
+// The kernels are compiled for several instruction sets and the dynamic
+// loader picks the best one supported by the cpu.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NN_MATH_KERNEL \
+    __attribute__((flatten, target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define NN_MATH_KERNEL
+#endif
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "NeuralNetwork/Math/Exp.h"
+#include "NeuralNetwork/Math/Tanh.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace nn::math {
+
+    /// @brief math policies select how the activation functions evaluate
+    /// sigmoid and tanh. Every policy provides the scalar functions and the
+    /// versions for n values, where in and out may be the same array.
+
+    /// @brief the policy the activation functions use for Var instead of
+    /// MathPolicy. Number types with integer approximations of their own
+    /// specialize it, see FixedPoint.
+    template< typename MathPolicy, typename Var >
+    struct select_policy {
+        using type = MathPolicy;
+    };
+
+    template< typename MathPolicy, typename Var >
+    using select_policy_t = typename select_policy< MathPolicy, Var >::type;
+
+    /// @brief exp based evaluation, precise up to a few ulp. Works for any
+    /// Var which provides exp, either std::exp or one found by the argument
+    /// dependent lookup.
+    struct Exact {
+        template< typename Var >
+        static Var sigmoid(const Var& x) {
+            using std::exp;
+            return Var{1.f} / (Var{1.f} + exp(-x));
+        }
+
+        template< typename Var >
+        static Var tanh(const Var& x) {
+            using std::exp;
+            return Var{2.f} / (Var{1.f} + exp(Var{-2.f} * x)) - Var{1.f};
+        }
+
+        template< typename Var >
+        static void sigmoid(const Var* in, Var* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = -in[i];
+            }
+            math::exp(out, out, n);
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = Var{1.f} / (Var{1.f} + out[i]);
+            }
+        }
+
+        template< typename Var >
+        static void tanh(const Var* in, Var* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = Var{-2.f} * in[i];
+            }
+            math::exp(out, out, n);
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = Var{2.f} / (Var{1.f} + out[i]) - Var{1.f};
+            }
+        }
+    };
+
+    /// @brief rational approximation of tanh, sigmoid(x) = (1 + tanh(x / 2)) / 2.
+    /// No exp and no branches, the absolute error is below 1e-6.
+    struct Polynomial {
+        template< typename Var >
+        static Var sigmoid(const Var& x) {
+            return detail::fastSigmoid(x);
+        }
+
+        template< typename Var >
+        static Var tanh(const Var& x) {
+            return detail::fastTanh(x);
+        }
+
+        template< typename Var >
+        static void sigmoid(const Var* in, Var* out, std::size_t n) {
+            fastSigmoid(in, out, n);
+        }
+
+        template< typename Var >
+        static void tanh(const Var* in, Var* out, std::size_t n) {
+            fastTanh(in, out, n);
+        }
+    };
+
+    namespace detail {
+        /// @brief exp usable in constant expressions. exp(x) = exp(x / 2^k)^(2^k)
+        /// with |x / 2^k| < 1 / 16 where a short taylor series is exact
+        /// in double.
+        constexpr double constexprExp(double x) {
+            int squarings = 4;
+            for(double limit = 1.; x > limit || x < -limit; limit *= 2.) {
+                ++squarings;
+            }
+            for(int i = 0; i < squarings; ++i) {
+                x /= 2.;
+            }
+
+            double term = 1.;
+            double result = 1.;
+            for(int i = 1; i < 10; ++i) {
+                term *= x / i;
+                result += term;
+            }
+            for(int i = 0; i < squarings; ++i) {
+                result *= result;
+            }
+            return result;
+        }
+    } // namespace detail
+
+    /// @brief sigmoid sampled at compile time on [-range, range] and
+    /// linearly interpolated. The values outside of the range are clamped,
+    /// tanh(x) = 2 * sigmoid(2 * x) - 1. With the default parameters the
+    /// absolute error is below 1e-6 for sigmoid and 3e-6 for tanh.
+    template< std::size_t points = 4096, int range = 16 >
+    struct LookupTable {
+        static_assert(points >= 2, "the table needs at least two points");
+        static_assert(range > 0, "the range must be positive");
+
+        template< typename Var >
+        static Var sigmoid(const Var& x) {
+            constexpr Var lo = -Var(range);
+            constexpr Var scale = Var(points - 1) / Var(2 * range);
+            constexpr Var last = Var(points - 1);
+            const auto& values = table< Var >;
+
+            Var position = (x - lo) * scale;
+            position = position < Var{0} ? Var{0} : position;
+            position = position > last ? last : position;
+            // the last point is duplicated, so index + 1 is always valid
+            const auto index = static_cast< std::size_t >(position);
+            const Var fraction = position - static_cast< Var >(index);
+            return values[index] + fraction * (values[index + 1] - values[index]);
+        }
+
+        template< typename Var >
+        static Var tanh(const Var& x) {
+            return Var{2.f} * sigmoid(Var{2.f} * x) - Var{1.f};
+        }
+
+        template< typename Var >
+        static void sigmoid(const Var* in, Var* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = sigmoid(in[i]);
+            }
+        }
+
+        template< typename Var >
+        static void tanh(const Var* in, Var* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = tanh(in[i]);
+            }
+        }
+
+      private:
+        template< typename Var >
+        static constexpr std::array< Var, points + 1 > generate() {
+            std::array< Var, points + 1 > values{};
+            for(std::size_t i = 0; i < points; ++i) {
+                const double x = -range + 2. * range * static_cast< double >(i) / (points - 1);
+                values[i] = static_cast< Var >(1. / (1. + detail::constexprExp(-x)));
+            }
+            values[points] = values[points - 1];
+            return values;
+        }
+
+        template< typename Var >
+        static constexpr std::array< Var, points + 1 > table = generate< Var >();
+    };
+} // namespace nn::math
@@ -0,0 +1,26 @@
+#include "NeuralNetwork/Math/Quantize.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL void quantize(const float* in, float scale, std::int8_t* out, std::size_t n) {
+        detail::quantize(in, scale, out, n);
+    }
+
+    NN_MATH_KERNEL void quantize(const double* in, double scale, std::int8_t* out, std::size_t n) {
+        detail::quantize(in, scale, out, n);
+    }
+
+    NN_MATH_KERNEL std::int32_t dot(const std::int8_t* a, const std::int8_t* b, std::size_t n) {
+        return detail::dot(a, b, n);
+    }
+
+    NN_MATH_KERNEL void gemv(std::size_t m,
+                             std::size_t n,
+                             const std::int8_t* a,
+                             std::size_t lda,
+                             const std::int8_t* x,
+                             std::int32_t* y) {
+        detail::gemv(m, n, a, lda, x, y);
+    }
+} // namespace nn::math
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nn::math {
+
+    namespace detail {
+        /// @brief out[i] = round(in[i] / scale) saturated to [-127, 127]. The
+        /// symmetric range keeps -x representable for every quantized x.
+        template< typename Var >
+        inline void quantize(const Var* __restrict in, Var scale, std::int8_t* __restrict out, std::size_t n) {
+            const Var inverse = Var{1} / scale;
+            for(std::size_t i = 0; i < n; ++i) {
+                Var value = in[i] * inverse;
+                value = value < Var{-127} ? Var{-127} : value;
+                value = value > Var{127} ? Var{127} : value;
+                out[i] = static_cast< std::int8_t >(value < Var{0} ? value - Var{0.5} : value + Var{0.5});
+            }
+        }
+
+        inline std::int32_t dot(const std::int8_t* __restrict a, const std::int8_t* __restrict b, std::size_t n) {
+            std::int32_t result = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                result += static_cast< std::int32_t >(a[i]) * static_cast< std::int32_t >(b[i]);
+            }
+            return result;
+        }
+
+        inline void gemv(std::size_t m,
+                         std::size_t n,
+                         const std::int8_t* a,
+                         std::size_t lda,
+                         const std::int8_t* x,
+                         std::int32_t* y) {
+            for(std::size_t i = 0; i < m; ++i) {
+                y[i] += dot(a + i * lda, x, n);
+            }
+        }
+    } // namespace detail
+
+    template< typename Var >
+    void quantize(const Var* in, Var scale, std::int8_t* out, std::size_t n) {
+        detail::quantize(in, scale, out, n);
+    }
+
+    void quantize(const float* in, float scale, std::int8_t* out, std::size_t n);
+    void quantize(const double* in, double scale, std::int8_t* out, std::size_t n);
+
+    /// @brief int8 dot product accumulated in int32. The sum can't overflow
+    /// for n < 2^17.
+    std::int32_t dot(const std::int8_t* a, const std::int8_t* b, std::size_t n);
+
+    /// @brief y += A * x for the row-major int8 matrix A (m x n) with the
+    /// leading dimension lda, accumulated in int32.
+    void gemv(std::size_t m,
+              std::size_t n,
+              const std::int8_t* a,
+              std::size_t lda,
+              const std::int8_t* x,
+              std::int32_t* y);
+} // namespace nn::math
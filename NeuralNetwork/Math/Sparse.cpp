@@ -0,0 +1,65 @@
+#include "NeuralNetwork/Math/Sparse.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL void spmv(std::size_t m,
+                             const std::uint32_t* rowOffsets,
+                             const std::uint32_t* columns,
+                             const float* values,
+                             const float* x,
+                             float* y) {
+        detail::spmv(m, rowOffsets, columns, values, x, y);
+    }
+
+    NN_MATH_KERNEL void spmv(std::size_t m,
+                             const std::uint32_t* rowOffsets,
+                             const std::uint32_t* columns,
+                             const double* values,
+                             const double* x,
+                             double* y) {
+        detail::spmv(m, rowOffsets, columns, values, x, y);
+    }
+
+    NN_MATH_KERNEL void maskedGemv(std::size_t m,
+                                   const std::uint32_t* rowOffsets,
+                                   const std::uint32_t* columns,
+                                   const float* a,
+                                   std::size_t lda,
+                                   const float* x,
+                                   float* y) {
+        detail::maskedGemv(m, rowOffsets, columns, a, lda, x, y);
+    }
+
+    NN_MATH_KERNEL void maskedGemv(std::size_t m,
+                                   const std::uint32_t* rowOffsets,
+                                   const std::uint32_t* columns,
+                                   const double* a,
+                                   std::size_t lda,
+                                   const double* x,
+                                   double* y) {
+        detail::maskedGemv(m, rowOffsets, columns, a, lda, x, y);
+    }
+
+    NN_MATH_KERNEL void maskedGer(std::size_t m,
+                                  const std::uint32_t* rowOffsets,
+                                  const std::uint32_t* columns,
+                                  float alpha,
+                                  const float* x,
+                                  const float* y,
+                                  float* a,
+                                  std::size_t lda) {
+        detail::maskedGer(m, rowOffsets, columns, alpha, x, y, a, lda);
+    }
+
+    NN_MATH_KERNEL void maskedGer(std::size_t m,
+                                  const std::uint32_t* rowOffsets,
+                                  const std::uint32_t* columns,
+                                  double alpha,
+                                  const double* x,
+                                  const double* y,
+                                  double* a,
+                                  std::size_t lda) {
+        detail::maskedGer(m, rowOffsets, columns, alpha, x, y, a, lda);
+    }
+} // namespace nn::math
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "NeuralNetwork/Math/Dot.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nn::math {
+
+    /// @brief the sparse kernels take a matrix in the compressed sparse row
+    /// format: the non zero elements of row i are at the positions
+    /// [rowOffsets[i], rowOffsets[i + 1]) of columns and values.
+
+    namespace detail {
+        /// @brief dot product of the n elements of a sparse row and the dense
+        /// vector x. weight(k, columns[k]) returns the k-th element of the
+        /// row. Uses independent accumulators like the dense dot product,
+        /// a single one would make every addition wait for the previous one.
+        template< typename Var, typename Weight >
+        inline Var sparseDot(const std::uint32_t* columns,
+                             const Var* __restrict x,
+                             std::size_t n,
+                             Weight weight) {
+            constexpr auto width = lanes< Var >();
+            Var acc[width] = {};
+            std::size_t k = 0;
+            for(; k + width <= n; k += width) {
+                for(std::size_t j = 0; j < width; ++j) {
+                    acc[j] += weight(k + j, columns[k + j]) * x[columns[k + j]];
+                }
+            }
+
+            for(std::size_t half = width / 2; half > 0; half /= 2) {
+                for(std::size_t j = 0; j < half; ++j) {
+                    acc[j] += acc[j + half];
+                }
+            }
+
+            Var result = acc[0];
+            for(; k < n; ++k) {
+                result += weight(k, columns[k]) * x[columns[k]];
+            }
+            return result;
+        }
+
+        template< typename Var >
+        inline void spmv(std::size_t m,
+                         const std::uint32_t* rowOffsets,
+                         const std::uint32_t* columns,
+                         const Var* values,
+                         const Var* __restrict x,
+                         Var* __restrict y) {
+            for(std::size_t i = 0; i < m; ++i) {
+                const auto begin = rowOffsets[i];
+                const auto weight = [values = values + begin](std::size_t k, std::uint32_t) {
+                    return values[k];
+                };
+                y[i] += sparseDot< Var >(columns + begin, x, rowOffsets[i + 1] - begin, weight);
+            }
+        }
+
+        template< typename Var >
+        inline void maskedGemv(std::size_t m,
+                               const std::uint32_t* rowOffsets,
+                               const std::uint32_t* columns,
+                               const Var* a,
+                               std::size_t lda,
+                               const Var* __restrict x,
+                               Var* __restrict y) {
+            for(std::size_t i = 0; i < m; ++i) {
+                const auto begin = rowOffsets[i];
+                const auto weight = [row = a + i * lda](std::size_t, std::uint32_t column) {
+                    return row[column];
+                };
+                y[i] += sparseDot< Var >(columns + begin, x, rowOffsets[i + 1] - begin, weight);
+            }
+        }
+
+        template< typename Var >
+        inline void maskedGer(std::size_t m,
+                              const std::uint32_t* rowOffsets,
+                              const std::uint32_t* columns,
+                              Var alpha,
+                              const Var* __restrict x,
+                              const Var* __restrict y,
+                              Var* __restrict a,
+                              std::size_t lda) {
+            for(std::size_t i = 0; i < m; ++i) {
+                Var* row = a + i * lda;
+                const Var scaled = alpha * x[i];
+                for(auto k = rowOffsets[i]; k < rowOffsets[i + 1]; ++k) {
+                    row[columns[k]] += scaled * y[columns[k]];
+                }
+            }
+        }
+    } // namespace detail
+
+    /// @brief y += A * x for the sparse matrix A with m rows.
+    template< typename Var >
+    void spmv(std::size_t m,
+              const std::uint32_t* rowOffsets,
+              const std::uint32_t* columns,
+              const Var* values,
+              const Var* x,
+              Var* y) {
+        detail::spmv(m, rowOffsets, columns, values, x, y);
+    }
+
+    /// @brief y += A * x where A is the row-major dense matrix a (m x lda)
+    /// restricted to the elements of the sparsity pattern. The other
+    /// elements of a are never read.
+    template< typename Var >
+    void maskedGemv(std::size_t m,
+                    const std::uint32_t* rowOffsets,
+                    const std::uint32_t* columns,
+                    const Var* a,
+                    std::size_t lda,
+                    const Var* x,
+                    Var* y) {
+        detail::maskedGemv(m, rowOffsets, columns, a, lda, x, y);
+    }
+
+    /// @brief A += alpha * x * y^T for the elements of the row-major dense
+    /// matrix a (m x lda) which belong to the sparsity pattern. The other
+    /// elements are left untouched.
+    template< typename Var >
+    void maskedGer(std::size_t m,
+                   const std::uint32_t* rowOffsets,
+                   const std::uint32_t* columns,
+                   Var alpha,
+                   const Var* x,
+                   const Var* y,
+                   Var* a,
+                   std::size_t lda) {
+        detail::maskedGer(m, rowOffsets, columns, alpha, x, y, a, lda);
+    }
+
+    void spmv(std::size_t m,
+              const std::uint32_t* rowOffsets,
+              const std::uint32_t* columns,
+              const float* values,
+              const float* x,
+              float* y);
+    void spmv(std::size_t m,
+              const std::uint32_t* rowOffsets,
+              const std::uint32_t* columns,
+              const double* values,
+              const double* x,
+              double* y);
+
+    void maskedGemv(std::size_t m,
+                    const std::uint32_t* rowOffsets,
+                    const std::uint32_t* columns,
+                    const float* a,
+                    std::size_t lda,
+                    const float* x,
+                    float* y);
+    void maskedGemv(std::size_t m,
+                    const std::uint32_t* rowOffsets,
+                    const std::uint32_t* columns,
+                    const double* a,
+                    std::size_t lda,
+                    const double* x,
+                    double* y);
+
+    void maskedGer(std::size_t m,
+                   const std::uint32_t* rowOffsets,
+                   const std::uint32_t* columns,
+                   float alpha,
+                   const float* x,
+                   const float* y,
+                   float* a,
+                   std::size_t lda);
+    void maskedGer(std::size_t m,
+                   const std::uint32_t* rowOffsets,
+                   const std::uint32_t* columns,
+                   double alpha,
+                   const double* x,
+                   const double* y,
+                   double* a,
+                   std::size_t lda);
+} // namespace nn::math
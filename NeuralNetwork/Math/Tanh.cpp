@@ -0,0 +1,21 @@
+#include "NeuralNetwork/Math/Tanh.h"
+#include "NeuralNetwork/Math/Kernel.h"
+
+namespace nn::math {
+
+    NN_MATH_KERNEL void fastTanh(const float* in, float* out, std::size_t n) {
+        detail::fastTanh(in, out, n);
+    }
+
+    NN_MATH_KERNEL void fastTanh(const double* in, double* out, std::size_t n) {
+        detail::fastTanh(in, out, n);
+    }
+
+    NN_MATH_KERNEL void fastSigmoid(const float* in, float* out, std::size_t n) {
+        detail::fastSigmoid(in, out, n);
+    }
+
+    NN_MATH_KERNEL void fastSigmoid(const double* in, double* out, std::size_t n) {
+        detail::fastSigmoid(in, out, n);
+    }
+} // namespace nn::math
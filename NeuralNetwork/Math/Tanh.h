@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace nn::math {
+
+    namespace detail {
+        /// @brief rational approximation of tanh on [-7.9, 7.9] (odd polynomial
+        /// of degree 13 over even polynomial of degree 6), outside of the
+        /// interval tanh is 1 or -1 in float precision.
+        template< typename Var >
+        inline Var fastTanh(Var value) {
+            constexpr Var limit = Var(7.90531110763549805);
+            const Var x = std::min(std::max(value, -limit), limit);
+            const Var x2 = x * x;
+
+            Var p = Var(-2.76076847742355e-16);
+            p = p * x2 + Var(2.00018790482477e-13);
+            p = p * x2 + Var(-8.60467152213735e-11);
+            p = p * x2 + Var(5.12229709037114e-08);
+            p = p * x2 + Var(1.48572235717979e-05);
+            p = p * x2 + Var(6.37261928875436e-04);
+            p = p * x2 + Var(4.89352455891786e-03);
+            p = p * x;
+
+            Var q = Var(1.19825839466702e-06);
+            q = q * x2 + Var(1.18534705686654e-04);
+            q = q * x2 + Var(2.26843463243900e-03);
+            q = q * x2 + Var(4.89352518554385e-03);
+            return p / q;
+        }
+
+        template< typename Var >
+        inline Var fastSigmoid(Var x) {
+            return Var(0.5) + Var(0.5) * fastTanh(Var(0.5) * x);
+        }
+
+        template< typename Var >
+        inline void fastTanh(const Var* in, Var* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = fastTanh(in[i]);
+            }
+        }
+
+        template< typename Var >
+        inline void fastSigmoid(const Var* in, Var* out, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i) {
+                out[i] = fastSigmoid(in[i]);
+            }
+        }
+    } // namespace detail
+
+    /// @brief tanh with the absolute error below 1e-6, without exp and
+    /// branches. in and out may be the same array.
+    template< typename Var >
+    void fastTanh(const Var* in, Var* out, std::size_t n) {
+        detail::fastTanh(in, out, n);
+    }
+
+    /// @brief 1 / (1 + exp(-x)) computed as (1 + tanh(x / 2)) / 2.
+    template< typename Var >
+    void fastSigmoid(const Var* in, Var* out, std::size_t n) {
+        detail::fastSigmoid(in, out, n);
+    }
+
+    void fastTanh(const float* in, float* out, std::size_t n);
+    void fastTanh(const double* in, double* out, std::size_t n);
+    void fastSigmoid(const float* in, float* out, std::size_t n);
+    void fastSigmoid(const double* in, double* out, std::size_t n);
+} // namespace nn::math
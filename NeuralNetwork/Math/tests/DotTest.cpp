@@ -0,0 +1,58 @@
+#include "NeuralNetwork/Math/Dot.h"
+
+#include <cstddef>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    template< typename Var >
+    std::vector< Var > sequence(std::size_t n, Var scale) {
+        std::vector< Var > result(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            result[i] = static_cast< Var >((i % 7) + 1) * scale;
+        }
+        return result;
+    }
+
+    template< typename Var >
+    Var naiveDot(const std::vector< Var >& a, const std::vector< Var >& b) {
+        Var result{};
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    TEMPLATE_TEST_CASE("dot product kernel", "[math][dot]", float, double) {
+        for(std::size_t n : {0, 1, 3, 16, 31, 32, 33, 180, 257}) {
+            const auto a = sequence< TestType >(n, TestType{0.5});
+            const auto b = sequence< TestType >(n, TestType{-0.25});
+            REQUIRE(nn::math::dot(a.data(), b.data(), n) ==
+                    Catch::Approx(naiveDot(a, b)).epsilon(1e-5));
+        }
+    }
+
+    TEST_CASE("dot product kernel for a generic type", "[math][dot]") {
+        const std::vector< int > a{1, 2, 3, 4, 5};
+        const std::vector< int > b{5, 4, 3, 2, 1};
+        REQUIRE(nn::math::dot(a.data(), b.data(), a.size()) == 35);
+    }
+
+    TEMPLATE_TEST_CASE("axpy kernel", "[math][axpy]", float, double) {
+        for(std::size_t n : {0, 1, 7, 64, 181}) {
+            const auto x = sequence< TestType >(n, TestType{1});
+            auto y = sequence< TestType >(n, TestType{2});
+            auto expected = y;
+            for(std::size_t i = 0; i < n; ++i) {
+                expected[i] += TestType{-0.5} * x[i];
+            }
+
+            nn::math::axpy(TestType{-0.5}, x.data(), y.data(), n);
+            for(std::size_t i = 0; i < n; ++i) {
+                REQUIRE(y[i] == Catch::Approx(expected[i]));
+            }
+        }
+    }
+} // namespace
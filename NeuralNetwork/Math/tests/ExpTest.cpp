@@ -0,0 +1,35 @@
+#include "NeuralNetwork/Math/Exp.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    TEMPLATE_TEST_CASE("vectorized exp", "[math][exp]", float, double) {
+        const TestType limit = sizeof(TestType) == sizeof(float) ? TestType{87} : TestType{700};
+        constexpr std::size_t n = 10007;
+        std::vector< TestType > values(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            values[i] = -limit + TestType{2} * limit * static_cast< TestType >(i) / TestType{n};
+        }
+
+        std::vector< TestType > results(n);
+        nn::math::exp(values.data(), results.data(), n);
+        for(std::size_t i = 0; i < n; ++i) {
+            REQUIRE(results[i] == Catch::Approx(std::exp(values[i])).epsilon(
+                                   sizeof(TestType) == sizeof(float) ? 1e-6 : 1e-13));
+        }
+    }
+
+    TEMPLATE_TEST_CASE("vectorized exp out of range", "[math][exp]", float, double) {
+        std::vector< TestType > values{TestType{-1e4}, TestType{1e4}, TestType{0}};
+        nn::math::exp(values.data(), values.data(), values.size());
+        REQUIRE(values[0] == TestType{0});
+        REQUIRE(values[1] == std::numeric_limits< TestType >::infinity());
+        REQUIRE(values[2] == TestType{1});
+    }
+} // namespace
@@ -0,0 +1,70 @@
+#include "NeuralNetwork/Math/Fft.h"
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using nn::math::Direction;
+
+    template< typename Var >
+    std::vector< std::complex< Var > > naiveDft(const std::vector< std::complex< Var > >& x, Direction direction) {
+        const auto n = x.size();
+        const double sign = direction == Direction::Forward ? -1 : 1;
+        std::vector< std::complex< Var > > result(n);
+        for(std::size_t k = 0; k < n; ++k) {
+            std::complex< double > sum{};
+            for(std::size_t j = 0; j < n; ++j) {
+                const double angle = sign * 2 * std::numbers::pi * static_cast< double >(j * k % n) / static_cast< double >(n);
+                sum += std::complex< double >(x[j]) * std::polar(1.0, angle);
+            }
+            result[k] = std::complex< Var >(sum);
+        }
+        return result;
+    }
+
+    TEST_CASE("fft sizes have the prime factors 2, 3 and 5", "[math][fft]") {
+        REQUIRE(nn::math::fftSize(0) == 1);
+        REQUIRE(nn::math::fftSize(7) == 8);
+        REQUIRE(nn::math::fftSize(11) == 12);
+        REQUIRE(nn::math::fftSize(70) == 72);
+        REQUIRE(nn::math::fftSize(128) == 128);
+        static_assert(nn::math::fftSize(31) == 32);
+    }
+
+    TEMPLATE_TEST_CASE("fft kernel", "[math][fft]", float, double) {
+        const std::size_t n = GENERATE(1, 2, 3, 4, 5, 6, 8, 12, 15, 16, 18, 20, 30, 45, 64, 72, 120);
+        const auto direction = GENERATE(Direction::Forward, Direction::Inverse);
+        const std::size_t stride = GENERATE(1, 3);
+
+        std::vector< std::complex< TestType > > x(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            x[i] = {static_cast< TestType >(std::sin(static_cast< double >(i))),
+                    static_cast< TestType >(std::cos(static_cast< double >(3 * i)))};
+        }
+        const auto expected = naiveDft(x, direction);
+
+        // the values of another transform are in between and stay untouched
+        std::vector< std::complex< TestType > > data(n * stride, {TestType{7}, TestType{-7}});
+        for(std::size_t i = 0; i < n; ++i) {
+            data[i * stride] = x[i];
+        }
+        const nn::math::FftPlan< TestType > plan(n);
+        std::vector< std::complex< TestType > > scratch(2 * n);
+        nn::math::fft(plan, direction, data.data(), stride, scratch.data());
+
+        for(std::size_t i = 0; i < data.size(); ++i) {
+            if(i % stride == 0) {
+                REQUIRE(data[i].real() == Catch::Approx(expected[i / stride].real()).margin(1e-4));
+                REQUIRE(data[i].imag() == Catch::Approx(expected[i / stride].imag()).margin(1e-4));
+            } else {
+                REQUIRE(data[i] == std::complex< TestType >{TestType{7}, TestType{-7}});
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,150 @@
+#include "NeuralNetwork/Math/FixedPoint.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Fixed = nn::math::FixedPoint<>;
+    using Small = nn::math::FixedPoint< 4, std::int8_t >;
+
+    SCENARIO("fixed point arithmetic", "[math][fixed]") {
+        GIVEN("values which are exactly representable") {
+            const Fixed a(1.5f);
+            const Fixed b(-0.25);
+            THEN("the operations are exact") {
+                REQUIRE(static_cast< float >(a + b) == 1.25f);
+                REQUIRE(static_cast< float >(a - b) == 1.75f);
+                REQUIRE(static_cast< float >(a * b) == -0.375f);
+                REQUIRE(static_cast< float >(a / b) == -6.f);
+                REQUIRE(static_cast< float >(-a) == -1.5f);
+                REQUIRE(a > b);
+                REQUIRE(Fixed(3) == Fixed(3.f));
+                REQUIRE(static_cast< int >(Fixed(-2.75f)) == -2);
+            }
+        }
+
+        GIVEN("values which are not representable") {
+            THEN("they are rounded to the nearest one") {
+                REQUIRE(Fixed(1.f / 3.f).raw() == 21845);
+                REQUIRE(Fixed(-1.f / 3.f).raw() == -21845);
+                REQUIRE((Fixed(1) / Fixed(3)).raw() == 21845);
+                REQUIRE((Fixed(-2) / Fixed(3)).raw() == -43691);
+                REQUIRE((Fixed::epsilon() * Fixed(0.5f)).raw() == 1);
+                REQUIRE(static_cast< double >(Fixed(0.1)) == Catch::Approx(0.1).margin(1e-5));
+            }
+        }
+
+        GIVEN("results out of the range") {
+            THEN("they saturate instead of wrapping around") {
+                REQUIRE(Fixed(40000.f) == Fixed::max());
+                REQUIRE(Fixed(-40000) == Fixed::lowest());
+                REQUIRE(Fixed(30000) + Fixed(30000) == Fixed::max());
+                REQUIRE(Fixed(-30000) - Fixed(30000) == Fixed::lowest());
+                REQUIRE(Fixed(300) * Fixed(-300) == Fixed::lowest());
+                REQUIRE(-Fixed::lowest() == Fixed::max());
+                REQUIRE(Small(7) + Small(1) == Small::max());
+                REQUIRE(Small(-5) * Small(2) == Small::lowest());
+            }
+            THEN("the division by zero saturates with the sign of the dividend") {
+                REQUIRE(Fixed(1) / Fixed{} == Fixed::max());
+                REQUIRE(Fixed(-1) / Fixed{} == Fixed::lowest());
+            }
+            THEN("NaN is converted to zero") {
+                REQUIRE(Fixed(std::nanf("")) == Fixed{});
+            }
+        }
+    }
+
+    SCENARIO("fixed point exp", "[math][fixed]") {
+        GIVEN("the arguments over the whole useful range") {
+            THEN("exp follows std::exp") {
+                for(float x = -12.f; x < 10.f; x += 0.0137f) {
+                    const auto expected = std::exp(static_cast< double >(Fixed(x)));
+                    const auto actual = static_cast< double >(exp(Fixed(x)));
+                    REQUIRE(actual == Catch::Approx(expected).epsilon(2e-4).margin(4e-5));
+                }
+            }
+            THEN("large arguments saturate and small ones vanish") {
+                REQUIRE(exp(Fixed(11)) == Fixed::max());
+                REQUIRE(exp(Fixed(1000)) == Fixed::max());
+                REQUIRE(exp(Fixed(-20)) == Fixed{});
+                REQUIRE(exp(Fixed::lowest()) == Fixed{});
+            }
+            THEN("exp can be evaluated at compile time") {
+                static_assert(exp(Fixed{}) == Fixed(1));
+            }
+        }
+    }
+
+    SCENARIO("fixed point sigmoid and tanh", "[math][fixed]") {
+        using Table = nn::math::IntegerLookupTable< 16, std::int32_t >;
+
+        GIVEN("arguments inside of the range, at its limits and beyond") {
+            // raw argument, raw sigmoid, raw tanh
+            constexpr std::array< std::tuple< std::int32_t, std::int32_t, std::int32_t >, 18 > reference{{
+             {-2147483647 - 1, 0, -65536},
+             {-1310720, 0, -65536},
+             {-1048576, 0, -65536},
+             {-1048000, 0, -65536},
+             {-242483, 1582, -65456},
+             {-65536, 17625, -49912},
+             {-32768, 24743, -30286},
+             {-1, 32768, 0},
+             {0, 32768, 0},
+             {1, 32768, 2},
+             {7, 32770, 8},
+             {19661, 37647, 19090},
+             {65536, 47911, 49912},
+             {163840, 60565, 64658},
+             {509214, 65509, 65536},
+             {1047900, 65536, 65536},
+             {1048576, 65536, 65536},
+             {2147483647, 65536, 65536},
+            }};
+            THEN("the results are the ones of the reference bit by bit") {
+                for(const auto& [x, sigmoid, tanh] : reference) {
+                    REQUIRE(Table::sigmoid(Fixed::fromRaw(x)).raw() == sigmoid);
+                    REQUIRE(Table::tanh(Fixed::fromRaw(x)).raw() == tanh);
+                }
+            }
+            THEN("they can be evaluated at compile time") {
+                static_assert(Table::sigmoid(Fixed{}) == Fixed(0.5f));
+                static_assert(Table::tanh(Fixed{}) == Fixed{});
+            }
+        }
+
+        GIVEN("the arguments over the whole useful range") {
+            THEN("sigmoid and tanh follow the floating point ones") {
+                for(float x = -20.f; x < 20.f; x += 0.0137f) {
+                    const auto value = static_cast< double >(Fixed(x));
+                    const auto sigmoid = static_cast< double >(Table::sigmoid(Fixed(x)));
+                    const auto tanh = static_cast< double >(Table::tanh(Fixed(x)));
+                    REQUIRE(sigmoid == Catch::Approx(1. / (1. + std::exp(-value))).margin(3e-5));
+                    REQUIRE(tanh == Catch::Approx(std::tanh(value)).margin(5e-5));
+                }
+            }
+            THEN("narrow representations stay in their range") {
+                using SmallTable = nn::math::IntegerLookupTable< 4, std::int8_t >;
+                REQUIRE(SmallTable::sigmoid(Small{}) == Small(0.5f));
+                REQUIRE(SmallTable::sigmoid(Small::max()) == Small(1));
+                REQUIRE(SmallTable::sigmoid(Small::lowest()) == Small{});
+                REQUIRE(SmallTable::tanh(Small::max()) == Small(1));
+                REQUIRE(SmallTable::tanh(Small::lowest()) == Small(-1));
+            }
+        }
+
+        GIVEN("any math policy") {
+            THEN("fixed point numbers select the integer table") {
+                STATIC_REQUIRE(std::is_same_v< nn::math::select_policy_t< nn::math::Exact, Fixed >, Table >);
+                STATIC_REQUIRE(std::is_same_v< nn::math::select_policy_t< nn::math::Polynomial, Fixed >, Table >);
+                STATIC_REQUIRE(std::is_same_v< nn::math::select_policy_t< nn::math::Exact, float >, nn::math::Exact >);
+            }
+        }
+    }
+} // namespace
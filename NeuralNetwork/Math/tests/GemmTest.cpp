@@ -0,0 +1,135 @@
+#include "NeuralNetwork/Math/Gemm.h"
+
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using nn::math::Transpose;
+
+    template< typename Var >
+    std::vector< Var > sequence(std::size_t n, std::size_t period) {
+        std::vector< Var > result(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            result[i] = static_cast< Var >(static_cast< int >(i % period) - 3) / Var{8};
+        }
+        return result;
+    }
+
+    template< typename Var >
+    Var element(const std::vector< Var >& a, std::size_t ld, Transpose trans, std::size_t i, std::size_t j) {
+        return trans == Transpose::No ? a[i * ld + j] : a[j * ld + i];
+    }
+
+    template< typename Var >
+    std::vector< Var > naiveGemm(Transpose transA,
+                                 Transpose transB,
+                                 std::size_t m,
+                                 std::size_t n,
+                                 std::size_t k,
+                                 Var alpha,
+                                 const std::vector< Var >& a,
+                                 const std::vector< Var >& b,
+                                 Var beta,
+                                 std::vector< Var > c) {
+        const auto lda = transA == Transpose::No ? k : m;
+        const auto ldb = transB == Transpose::No ? n : k;
+        for(std::size_t i = 0; i < m; ++i) {
+            for(std::size_t j = 0; j < n; ++j) {
+                Var sum{};
+                for(std::size_t p = 0; p < k; ++p) {
+                    sum += element(a, lda, transA, i, p) * element(b, ldb, transB, p, j);
+                }
+                c[i * n + j] = alpha * sum + beta * c[i * n + j];
+            }
+        }
+        return c;
+    }
+
+    TEMPLATE_TEST_CASE("gemm kernel", "[math][gemm]", float, double) {
+        const auto [transA, transB] =
+         GENERATE(std::make_tuple(Transpose::No, Transpose::No),
+                  std::make_tuple(Transpose::No, Transpose::Yes),
+                  std::make_tuple(Transpose::Yes, Transpose::No),
+                  std::make_tuple(Transpose::Yes, Transpose::Yes));
+        const auto [m, n, k] = GENERATE(std::make_tuple(1, 1, 1),
+                                        std::make_tuple(7, 19, 5),
+                                        std::make_tuple(130, 37, 300),
+                                        std::make_tuple(13, 4200, 3));
+        const auto beta = GENERATE(TestType{0}, TestType{1}, TestType{0.5});
+
+        const auto a = sequence< TestType >(m * k, 7);
+        const auto b = sequence< TestType >(k * n, 5);
+        auto c = sequence< TestType >(m * n, 11);
+        const auto expected = naiveGemm(transA, transB, m, n, k, TestType{2}, a, b, beta, c);
+
+        nn::math::gemm(transA,
+                       transB,
+                       m,
+                       n,
+                       k,
+                       TestType{2},
+                       a.data(),
+                       transA == Transpose::No ? k : m,
+                       b.data(),
+                       transB == Transpose::No ? n : k,
+                       beta,
+                       c.data(),
+                       n);
+        for(std::size_t i = 0; i < c.size(); ++i) {
+            REQUIRE(c[i] == Catch::Approx(expected[i]).epsilon(1e-4).margin(1e-4));
+        }
+    }
+
+    TEMPLATE_TEST_CASE("gemm kernel with a prepacked matrix", "[math][gemm]", float, double) {
+        constexpr std::size_t m = 9, n = 21, k = 270;
+        const auto a = sequence< TestType >(m * k, 7);
+        const auto b = sequence< TestType >(n * k, 5);
+        std::vector< TestType > c(m * n);
+        const auto expected =
+         naiveGemm(Transpose::No, Transpose::Yes, m, n, k, TestType{1}, a, b, TestType{0}, c);
+
+        const nn::math::PackedMatrix< TestType > packed(Transpose::Yes, k, n, b.data(), k);
+        for(int repeat = 0; repeat < 2; ++repeat) {
+            nn::math::gemm(Transpose::No, m, TestType{1}, a.data(), k, packed, TestType{0}, c.data(), n);
+            for(std::size_t i = 0; i < c.size(); ++i) {
+                REQUIRE(c[i] == Catch::Approx(expected[i]).epsilon(1e-4).margin(1e-4));
+            }
+        }
+    }
+
+    TEMPLATE_TEST_CASE("gemv kernel", "[math][gemv]", float, double) {
+        constexpr std::size_t m = 13, n = 37;
+        const auto a = sequence< TestType >(m * n, 7);
+        const auto x = sequence< TestType >(m + n, 5);
+        const auto trans = GENERATE(Transpose::No, Transpose::Yes);
+        const auto rows = trans == Transpose::No ? m : n;
+        const auto cols = trans == Transpose::No ? n : m;
+
+        std::vector< TestType > y = sequence< TestType >(rows, 3);
+        const auto expected = naiveGemm(
+         trans, Transpose::No, rows, 1, cols, TestType{-1}, a, x, TestType{0.5}, y);
+
+        nn::math::gemv(trans, m, n, TestType{-1}, a.data(), n, x.data(), TestType{0.5}, y.data());
+        for(std::size_t i = 0; i < rows; ++i) {
+            REQUIRE(y[i] == Catch::Approx(expected[i]).epsilon(1e-5).margin(1e-5));
+        }
+    }
+
+    TEMPLATE_TEST_CASE("outer product kernel", "[math][ger]", float, double) {
+        constexpr std::size_t m = 5, n = 33;
+        const auto x = sequence< TestType >(m, 7);
+        const auto y = sequence< TestType >(n, 5);
+        auto a = sequence< TestType >(m * n, 11);
+        const auto expected = naiveGemm(
+         Transpose::No, Transpose::No, m, n, 1, TestType{0.25}, x, y, TestType{1}, a);
+
+        nn::math::ger(m, n, TestType{0.25}, x.data(), y.data(), a.data(), n);
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            REQUIRE(a[i] == Catch::Approx(expected[i]));
+        }
+    }
+} // namespace
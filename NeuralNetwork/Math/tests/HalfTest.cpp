@@ -0,0 +1,115 @@
+#include "NeuralNetwork/Math/Gemm.h"
+#include "NeuralNetwork/Math/Half.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+#ifdef NN_MATH_HAS_FLOAT16
+    using HalfTypes = std::tuple< nn::math::float16, nn::math::bfloat16 >;
+#else
+    using HalfTypes = std::tuple< nn::math::bfloat16 >;
+#endif
+
+    std::vector< float > sequence(std::size_t n, float scale) {
+        std::vector< float > result(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            result[i] = std::sin(static_cast< float >(i) * 0.7f) * scale;
+        }
+        return result;
+    }
+
+    template< typename Storage >
+    std::vector< Storage > narrow(const std::vector< float >& values) {
+        std::vector< Storage > result(values.size());
+        nn::math::convert(values.data(), result.data(), values.size());
+        return result;
+    }
+
+    template< typename Storage >
+    std::vector< float > widen(const std::vector< Storage >& values) {
+        std::vector< float > result(values.size());
+        nn::math::convert(values.data(), result.data(), values.size());
+        return result;
+    }
+
+    SCENARIO("bfloat16 conversion", "[math][half]") {
+        GIVEN("values which are not representable in bfloat16") {
+            const float ulp = std::ldexp(1.f, -7);
+            THEN("they are rounded to the nearest even value") {
+                REQUIRE(static_cast< float >(nn::math::bfloat16(1.f)) == 1.f);
+                REQUIRE(static_cast< float >(nn::math::bfloat16(1.f + ulp / 2)) == 1.f);
+                REQUIRE(static_cast< float >(nn::math::bfloat16(1.f + 3 * ulp / 2)) == 1.f + 2 * ulp);
+                REQUIRE(static_cast< float >(nn::math::bfloat16(1.f + ulp / 4)) == 1.f);
+                REQUIRE(static_cast< float >(nn::math::bfloat16(-3.f)) == -3.f);
+            }
+            THEN("infinities and NaN are kept") {
+                const auto inf = std::numeric_limits< float >::infinity();
+                REQUIRE(static_cast< float >(nn::math::bfloat16(inf)) == inf);
+                REQUIRE(static_cast< float >(nn::math::bfloat16(-inf)) == -inf);
+                REQUIRE(std::isnan(static_cast< float >(nn::math::bfloat16(std::nanf("")))));
+            }
+        }
+    }
+
+    TEMPLATE_LIST_TEST_CASE("half precision storage with float accumulation", "[math][half]", HalfTypes) {
+        GIVEN("a matrix stored in half precision") {
+            constexpr std::size_t m = 37;
+            constexpr std::size_t n = 70;
+            const auto a = narrow< TestType >(sequence(m * n, 2.f));
+            const auto reference = widen(a);
+            const auto x = sequence(n, 1.f);
+            const auto y = sequence(m, 1.f);
+
+            THEN("the conversion keeps the values within the precision of the type") {
+                const auto original = sequence(m * n, 2.f);
+                for(std::size_t i = 0; i < original.size(); ++i) {
+                    REQUIRE(reference[i] == Catch::Approx(original[i]).margin(2e-2));
+                }
+            }
+
+            THEN("the dot product is the one of the converted values") {
+                REQUIRE(nn::math::dot(a.data(), x.data(), n) ==
+                        Catch::Approx(nn::math::dot(reference.data(), x.data(), n)).epsilon(1e-5));
+            }
+
+            THEN("the matrix vector products are the ones of the converted values") {
+                std::vector< float > expected(m, 1.f);
+                std::vector< float > actual(m, 1.f);
+                nn::math::gemv(nn::math::Transpose::No, m, n, 0.5f, reference.data(), n, x.data(), 2.f, expected.data());
+                nn::math::gemv(nn::math::Transpose::No, m, n, 0.5f, a.data(), n, x.data(), 2.f, actual.data());
+                for(std::size_t i = 0; i < m; ++i) {
+                    REQUIRE(actual[i] == Catch::Approx(expected[i]).epsilon(1e-5));
+                }
+
+                std::vector< float > expectedT(n, 1.f);
+                std::vector< float > actualT(n, 1.f);
+                nn::math::gemv(nn::math::Transpose::Yes, m, n, 1.f, reference.data(), n, y.data(), 0.f, expectedT.data());
+                nn::math::gemv(nn::math::Transpose::Yes, m, n, 1.f, a.data(), n, y.data(), 0.f, actualT.data());
+                for(std::size_t i = 0; i < n; ++i) {
+                    REQUIRE(actualT[i] == Catch::Approx(expectedT[i]).epsilon(1e-5));
+                }
+            }
+
+            THEN("the matrix product is the one of the converted values") {
+                constexpr std::size_t batch = 5;
+                const auto inputs = sequence(batch * n, 1.f);
+                std::vector< float > expected(batch * m);
+                std::vector< float > actual(batch * m);
+                nn::math::gemm(nn::math::Transpose::No, nn::math::Transpose::Yes, batch, m, n, 1.f,
+                               inputs.data(), n, reference.data(), n, 0.f, expected.data(), m);
+                nn::math::gemm(nn::math::Transpose::No, nn::math::Transpose::Yes, batch, m, n, 1.f,
+                               inputs.data(), n, a.data(), n, 0.f, actual.data(), m);
+                for(std::size_t i = 0; i < expected.size(); ++i) {
+                    REQUIRE(actual[i] == Catch::Approx(expected[i]).epsilon(1e-5));
+                }
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,48 @@
+#include "NeuralNetwork/Math/Quantize.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    TEMPLATE_TEST_CASE("quantization rounds and saturates", "[math][quantize]", float, double) {
+        const std::vector< TestType > values{0, 0.4, 0.6, -0.4, -0.6, 1.5, -1.5, 126.6, 500, -500};
+        std::vector< std::int8_t > quantized(values.size());
+
+        nn::math::quantize(values.data(), TestType{1}, quantized.data(), values.size());
+        REQUIRE(quantized == std::vector< std::int8_t >{0, 0, 1, 0, -1, 2, -2, 127, 127, -127});
+
+        nn::math::quantize(values.data(), TestType{0.5}, quantized.data(), 3);
+        REQUIRE(quantized[1] == 1);
+        REQUIRE(quantized[2] == 1);
+    }
+
+    TEST_CASE("int8 dot product and matrix vector product", "[math][quantize]") {
+        for(std::size_t n : {0, 1, 15, 64, 257}) {
+            std::vector< std::int8_t > a(3 * n);
+            std::vector< std::int8_t > x(n);
+            for(std::size_t i = 0; i < a.size(); ++i) {
+                a[i] = static_cast< std::int8_t >(static_cast< int >(i * 37 % 255) - 127);
+            }
+            for(std::size_t i = 0; i < n; ++i) {
+                x[i] = static_cast< std::int8_t >(static_cast< int >(i * 91 % 255) - 127);
+            }
+
+            std::vector< std::int32_t > expected{1, 2, 3};
+            for(std::size_t row = 0; row < 3; ++row) {
+                for(std::size_t i = 0; i < n; ++i) {
+                    expected[row] += a[row * n + i] * x[i];
+                }
+            }
+
+            REQUIRE(nn::math::dot(a.data(), x.data(), n) == expected[0] - 1);
+
+            std::vector< std::int32_t > y{1, 2, 3};
+            nn::math::gemv(3, n, a.data(), n, x.data(), y.data());
+            REQUIRE(y == expected);
+        }
+    }
+} // namespace
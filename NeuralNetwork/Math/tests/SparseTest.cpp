@@ -0,0 +1,86 @@
+#include "NeuralNetwork/Math/Sparse.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    template< typename Var >
+    struct Pattern {
+        Pattern(std::size_t rows, std::size_t cols)
+         : dense(rows * cols) {
+            // every third element is kept, the second row is empty
+            for(std::size_t i = 0; i < rows; ++i) {
+                rowOffsets.push_back(static_cast< std::uint32_t >(values.size()));
+                for(std::size_t j = 0; j < cols; ++j) {
+                    if(i != 1 && (i + j) % 3 == 0) {
+                        dense[i * cols + j] = std::sin(static_cast< Var >(i * cols + j + 1));
+                        columns.push_back(static_cast< std::uint32_t >(j));
+                        values.push_back(dense[i * cols + j]);
+                    }
+                }
+            }
+            rowOffsets.push_back(static_cast< std::uint32_t >(values.size()));
+        }
+
+        std::vector< std::uint32_t > rowOffsets;
+        std::vector< std::uint32_t > columns;
+        std::vector< Var > values;
+        std::vector< Var > dense;
+    };
+
+    TEMPLATE_TEST_CASE("sparse matrix vector products", "[math][sparse]", float, double) {
+        constexpr std::size_t rows = 5;
+        constexpr std::size_t cols = 37;
+        const Pattern< TestType > pattern(rows, cols);
+
+        std::vector< TestType > x(cols);
+        for(std::size_t j = 0; j < cols; ++j) {
+            x[j] = std::cos(static_cast< TestType >(j));
+        }
+
+        std::vector< TestType > expected(rows, TestType{1});
+        for(std::size_t i = 0; i < rows; ++i) {
+            for(std::size_t j = 0; j < cols; ++j) {
+                expected[i] += pattern.dense[i * cols + j] * x[j];
+            }
+        }
+
+        SECTION("spmv uses the compressed values") {
+            std::vector< TestType > y(rows, TestType{1});
+            nn::math::spmv(rows, pattern.rowOffsets.data(), pattern.columns.data(), pattern.values.data(), x.data(), y.data());
+            for(std::size_t i = 0; i < rows; ++i) {
+                REQUIRE(y[i] == Catch::Approx(expected[i]).epsilon(1e-5));
+            }
+        }
+
+        SECTION("maskedGemv ignores the elements outside of the pattern") {
+            auto a = pattern.dense;
+            for(std::size_t i = 0; i < a.size(); ++i) {
+                a[i] = a[i] == TestType{} ? TestType{1000} : a[i];
+            }
+            std::vector< TestType > y(rows, TestType{1});
+            nn::math::maskedGemv(rows, pattern.rowOffsets.data(), pattern.columns.data(), a.data(), cols, x.data(), y.data());
+            for(std::size_t i = 0; i < rows; ++i) {
+                REQUIRE(y[i] == Catch::Approx(expected[i]).epsilon(1e-5));
+            }
+        }
+
+        SECTION("maskedGer updates the elements of the pattern only") {
+            std::vector< TestType > a(rows * cols, TestType{2});
+            std::vector< TestType > u{1, 2, 3, 4, 5};
+            nn::math::maskedGer(rows, pattern.rowOffsets.data(), pattern.columns.data(), TestType{0.5}, u.data(), x.data(), a.data(), cols);
+            for(std::size_t i = 0; i < rows; ++i) {
+                for(std::size_t j = 0; j < cols; ++j) {
+                    const bool inPattern = pattern.dense[i * cols + j] != TestType{};
+                    const TestType expectedValue = inPattern ? TestType{2} + TestType{0.5} * u[i] * x[j] : TestType{2};
+                    REQUIRE(a[i * cols + j] == Catch::Approx(expectedValue).epsilon(1e-5));
+                }
+            }
+        }
+    }
+} // namespace
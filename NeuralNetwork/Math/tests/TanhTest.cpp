@@ -0,0 +1,39 @@
+#include "NeuralNetwork/Math/Tanh.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    TEMPLATE_TEST_CASE("fast tanh and sigmoid kernels", "[math][tanh]", float, double) {
+        for(std::size_t n : {0, 1, 7, 64, 1001}) {
+            std::vector< TestType > values(n);
+            for(std::size_t i = 0; i < n; ++i) {
+                values[i] = static_cast< TestType >(i) / static_cast< TestType >(n) * 24 - 12;
+            }
+            std::vector< TestType > tanh(n);
+            std::vector< TestType > sigmoid(n);
+
+            nn::math::fastTanh(values.data(), tanh.data(), n);
+            nn::math::fastSigmoid(values.data(), sigmoid.data(), n);
+            for(std::size_t i = 0; i < n; ++i) {
+                REQUIRE(tanh[i] == Catch::Approx(std::tanh(values[i])).margin(1e-6));
+                REQUIRE(sigmoid[i] ==
+                        Catch::Approx(1 / (1 + std::exp(-values[i]))).margin(1e-6));
+            }
+        }
+    }
+
+    TEST_CASE("fast tanh saturates and passes nan through", "[math][tanh]") {
+        std::vector< float > values{-1e30f, -50.f, 50.f, 1e30f, NAN};
+        nn::math::fastTanh(values.data(), values.data(), values.size());
+        REQUIRE(values[0] == Catch::Approx(-1.f).margin(1e-6));
+        REQUIRE(values[1] == Catch::Approx(-1.f).margin(1e-6));
+        REQUIRE(values[2] == Catch::Approx(1.f).margin(1e-6));
+        REQUIRE(values[3] == Catch::Approx(1.f).margin(1e-6));
+        REQUIRE(std::isnan(values[4]));
+    }
+} // namespace
@@ -1,10 +1,17 @@
 #pragma once
 
+#include "NeuralNetwork/Math/Dot.h"
+#include "NeuralNetwork/Math/Gemm.h"
+
 #include <MPL/Tuple.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace nn {
 
@@ -16,6 +23,107 @@ namespace nn {
         static constexpr std::size_t size = w * h;
     };
 
+    /// @brief memory layout of a grid with several channels. NCHW stores
+    /// the channels one after another, each of them as a whole grid, NHWC
+    /// stores the channels of a grid position next to each other.
+    enum class Layout { NCHW, NHWC };
+
+    namespace detail {
+        using WindowIndex = std::uint32_t;
+
+        /// @brief position of an input in a window.
+        struct WindowConnection {
+            WindowIndex window;
+            WindowIndex local;
+        };
+
+        /**
+         * The index tables of a SlidingWindow, built in one pass. The tables
+         * of realistic grids (e.g. 64x64 with a 7x7 kernel) have hundreds of
+         * thousands of entries, too many for the limits of the constant
+         * evaluation, so only the ones of small grids are built at compile
+         * time (see constexprTableEntries).
+         */
+        template< std::size_t width, std::size_t height, typename K >
+        struct WindowTables {
+            static constexpr std::size_t windowsPerRow = (width + K::stride - 1) / K::stride;
+            static constexpr std::size_t windowsPerCol = (height + K::stride - 1) / K::stride;
+            static constexpr std::size_t framesNumber = windowsPerRow * windowsPerCol;
+            static constexpr std::size_t size = width * height;
+            static constexpr auto outside = static_cast< WindowIndex >(size);
+
+            /// @brief the number of window positions inside of the grid, the
+            /// columns inside of a window don't depend on its row.
+            static constexpr std::size_t connections() {
+                std::size_t columns = 0;
+                for(std::size_t x = 0; x < width; x += K::stride) {
+                    columns += std::min(K::width, width - x);
+                }
+                std::size_t rows = 0;
+                for(std::size_t y = 0; y < height; y += K::stride) {
+                    rows += std::min(K::height, height - y);
+                }
+                return columns * rows;
+            }
+
+            constexpr WindowTables() {
+                auto entry = gather.begin();
+                for(std::size_t winY = 0; winY < windowsPerCol * K::stride; winY += K::stride) {
+                    for(std::size_t winX = 0; winX < windowsPerRow * K::stride; winX += K::stride) {
+                        for(std::size_t y = winY; y < winY + K::height; ++y) {
+                            for(std::size_t x = winX; x < winX + K::width; ++x) {
+                                *entry++ = x < width && y < height ? static_cast< WindowIndex >(y * width + x)
+                                                                   : outside;
+                            }
+                        }
+                    }
+                }
+
+                for(const auto input : gather) {
+                    if(input != outside) {
+                        ++scatterOffsets[input + 1];
+                    }
+                }
+                for(std::size_t i = 0; i < size; ++i) {
+                    scatterOffsets[i + 1] += scatterOffsets[i];
+                }
+
+                // scatterOffsets[i] is used as the next free entry of input i,
+                // it is the first entry of input i + 1 afterwards. The windows
+                // are visited in order, so the ones of an input are sorted.
+                for(std::size_t i = 0; i < gather.size(); ++i) {
+                    if(gather[i] != outside) {
+                        scatter[scatterOffsets[gather[i]]++] = {static_cast< WindowIndex >(i / K::size),
+                                                                static_cast< WindowIndex >(i % K::size)};
+                    }
+                }
+                for(std::size_t i = size; i > 0; --i) {
+                    scatterOffsets[i] = scatterOffsets[i - 1];
+                }
+                scatterOffsets[0] = 0;
+            }
+
+            /// @brief the tables built at run time, the call is not a constant
+            /// expression, so the compiler doesn't try to evaluate it first.
+            static WindowTables build() {
+                return WindowTables{};
+            }
+
+            std::array< WindowIndex, framesNumber * K::size > gather{};
+            std::array< WindowIndex, size + 1 > scatterOffsets{};
+            std::array< WindowConnection, connections() > scatter{};
+        };
+
+        /// @brief the grids with up to this number of gather entries have
+        /// their tables built at compile time, the larger ones at the first
+        /// use. Building takes a few steps per entry, clang and MSVC stop the
+        /// constant evaluation after about a million of them.
+        inline constexpr std::size_t constexprTableEntries = std::size_t{1} << 15;
+
+        template< typename Tables >
+        inline constexpr Tables precomputedTables{};
+    } // namespace detail
+
     template< std::size_t Width, std::size_t Height, typename Kernel_ >
     struct SlidingWindow {
         using K = Kernel_;
@@ -30,7 +138,7 @@ namespace nn {
         static constexpr std::size_t height = gridHeight;
         static constexpr std::size_t size = width * height;
 
-        static bool contains(std::size_t inputId, std::size_t windowId) {
+        static constexpr bool contains(std::size_t inputId, std::size_t windowId) {
             const std::size_t winX = (windowId % windowsPerRow) * K::stride;
             const std::size_t winY = (windowId / windowsPerRow) * K::stride;
             const std::size_t inX = inputId % gridWidth;
@@ -39,18 +147,130 @@ namespace nn {
                     inY >= winY && inY < winY + K::height);
         }
 
-        static std::size_t localize(std::size_t inputId, std::size_t windowId) {
+        static constexpr std::size_t localize(std::size_t inputId, std::size_t windowId) {
             const std::size_t winX = (windowId % windowsPerRow) * K::stride;
             const std::size_t winY = (windowId / windowsPerRow) * K::stride;
             const std::size_t inX = inputId % gridWidth;
             const std::size_t inY = inputId / gridWidth;
             return (inY - winY) * K::width + (inX - winX);
         }
+
+        using Index = detail::WindowIndex;
+        using Tables = detail::WindowTables< Width, Height, Kernel_ >;
+
+        /// @brief the tables are built at compile time, otherwise at the
+        /// first use.
+        static constexpr bool precomputed = framesNumber * K::size <= detail::constexprTableEntries;
+
+        /// @brief the value of the gather table for the positions of a
+        /// window which are outside of the grid.
+        static constexpr Index outside = Tables::outside;
+
+        /// @brief the input of every position of every window, row-major
+        /// (framesNumber x K::size). Positions outside of the grid are
+        /// marked with outside.
+        static const auto& gather() {
+            return tables().gather;
+        }
+
+        /// @brief the windows of every input, the ones of input i are
+        /// scatter()[scatterOffsets()[i]] .. scatter()[scatterOffsets()[i + 1]].
+        static const auto& scatterOffsets() {
+            return tables().scatterOffsets;
+        }
+
+        static const auto& scatter() {
+            return tables().scatter;
+        }
+
+        /**
+         * Lowers the windows of the grid into a patch matrix, one row of
+         * K::size values per window. The parts of a window outside of the
+         * grid and the inputs from count on are zero.
+         * @param rowStride the distance between the rows of two windows,
+         * larger than K::size when the patches of several samples are
+         * interleaved.
+         */
+        template< typename Var >
+        static void im2col(const Var* in, std::size_t count, Var* patches, std::size_t rowStride = K::size) {
+            const std::size_t limit = count < size ? count : size;
+            const auto& table = gather();
+            for(std::size_t w = 0; w < framesNumber; ++w) {
+                const Index* window = table.data() + w * K::size;
+                for(std::size_t j = 0; j < K::size; ++j) {
+                    patches[j] = window[j] < limit ? in[window[j]] : Var{};
+                }
+                patches += rowStride;
+            }
+        }
+
+        /**
+         * The transposed lowering, out[i] is the sum of the values of all
+         * window positions input i belongs to, each multiplied by the
+         * factor of its window. The inputs from size on are zero.
+         * @param values row-major (framesNumber x K::size) matrix.
+         * @param factors one factor per window.
+         */
+        template< typename Var >
+        static void col2im(const Var* values, const Var* factors, Var* out, std::size_t count) {
+            const std::size_t limit = count < size ? count : size;
+            const auto& offsets = scatterOffsets();
+            const auto& connections = scatter();
+            for(std::size_t i = 0; i < limit; ++i) {
+                Var sum{};
+                for(auto c = offsets[i]; c < offsets[i + 1]; ++c) {
+                    const auto [window, local] = connections[c];
+                    sum += values[window * K::size + local] * factors[window];
+                }
+                out[i] = sum;
+            }
+            for(std::size_t i = limit; i < count; ++i) {
+                out[i] = Var{};
+            }
+        }
+
+        /// @brief same as above with the factor one for all windows.
+        template< typename Var >
+        static void col2im(const Var* values, Var* out, std::size_t count) {
+            const std::size_t limit = count < size ? count : size;
+            const auto& offsets = scatterOffsets();
+            const auto& connections = scatter();
+            for(std::size_t i = 0; i < limit; ++i) {
+                Var sum{};
+                for(auto c = offsets[i]; c < offsets[i + 1]; ++c) {
+                    const auto [window, local] = connections[c];
+                    sum += values[window * K::size + local];
+                }
+                out[i] = sum;
+            }
+            for(std::size_t i = limit; i < count; ++i) {
+                out[i] = Var{};
+            }
+        }
+
+      private:
+        static const Tables& tables() {
+            if constexpr(precomputed) {
+                return detail::precomputedTables< Tables >;
+            } else {
+                static const Tables instance = Tables::build();
+                return instance;
+            }
+        }
     };
 
     namespace detail {
         template< typename Internal, typename Grid >
         class ConvolutionLayer : private Internal {
+            static constexpr auto neuronInputs = Grid::K::size;
+
+            /// @brief true if the neurons have weights, pooling neurons
+            /// calculate their output from the window values only.
+            static constexpr bool weighted = requires(const typename Internal::Container::value_type& neuron,
+                                                      const typename Internal::Var* window) {
+                neuron.calcDotProduct(window, neuronInputs);
+            };
+
           public:
             using Var = typename Internal::Var;
             using ActivationFunctions = typename Internal::ActivationFunctions;
@@ -77,73 +297,163 @@ namespace nn {
             using wrap =
              ConvolutionLayer< typename Internal::template wrap< NewType >, Grid >;
 
+            /// @brief the windows of the last evaluated sample, one row of
+            /// K::size values per neuron.
+            using Patches = std::array< Var, size() * Grid::K::size >;
+
             void setInput(unsigned int inputId, const Var& value) {
+                if(inputId >= Grid::size) {
+                    return;
+                }
                 auto& self = *this;
-                for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
-                    auto& neuron = self[w];
-                    if(Grid::contains(inputId, w)) {
-                        neuron.setInput(Grid::localize(inputId, w), value);
-                    }
+                const auto& offsets = Grid::scatterOffsets();
+                const auto& scatter = Grid::scatter();
+                for(auto c = offsets[inputId]; c < offsets[inputId + 1]; ++c) {
+                    const auto [window, local] = scatter[c];
+                    self[window].setInput(local, value);
+                    m_patches[window * neuronInputs + local] = value;
                 }
             }
 
+            const Patches& patches() const {
+                return m_patches;
+            }
+
             template< typename Context, std::size_t myIdx >
             void calculateOutputs(Context& ctx) {
                 auto& myOutputs = std::get< myIdx >(ctx);
                 std::array< Var, size() > dotProducts;
-                Internal::for_each([&](auto i, auto& neuron) {
-                    dotProducts[i.value] = neuron.calcDotProduct();
-                });
-                Internal::for_each([&](auto i, auto& neuron) {
-                    const auto output = neuron.calculateOutput(
-                     dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
-                    myOutputs[i.value] = output;
-                });
+                Internal::calcDotProducts(dotProducts.data());
+                activate(dotProducts, myOutputs.data());
             }
 
+            /// @brief the outputs of the predecessor are lowered into the
+            /// patch matrix, the dot products are calculated row by row.
             template< typename Context, std::size_t myIdx, std::size_t predecessorIdx >
             void calculateOutputs(Context& ctx) {
-                auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
                 auto& myOutputs = std::get< myIdx >(ctx);
-                for (std::size_t i = 0; i < predecessorOutputs.size(); ++i) {
-                    setInput(i, predecessorOutputs[i]);
+                Grid::im2col(predecessorOutputs.data(), predecessorOutputs.size(), m_patches.data());
+                loadWindows();
+
+                std::array< Var, size() > dotProducts{};
+                if constexpr(weighted) {
+                    Internal::for_each([&](auto i, auto& neuron) {
+                        dotProducts[i.value] =
+                         neuron.calcDotProduct(m_patches.data() + i.value * neuronInputs, neuronInputs);
+                    });
                 }
-                std::array< Var, size() > dotProducts;
-                Internal::for_each([&](auto i, auto& neuron) {
-                    dotProducts[i.value] = neuron.calcDotProduct();
-                });
-                Internal::for_each([&](auto i, auto& neuron) {
-                    const auto output = neuron.calculateOutput(
-                     dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
-                    myOutputs[i.value] = output;
-                });
+                activate(dotProducts, myOutputs.data());
             }
 
             template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename W >
             void calculateOutputs(Context& ctx, const W& wctx) {
-                auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
                 auto& myOutputs = std::get< myIdx >(ctx);
                 const auto& weights = std::get< myIdx >(wctx.weights);
                 const auto& biases = std::get< myIdx >(wctx.biases);
-                for (std::size_t i = 0; i < predecessorOutputs.size(); ++i) {
-                    setInput(i, predecessorOutputs[i]);
-                }
-                constexpr auto neuronInputs = Internal::inputs();
+                Grid::im2col(predecessorOutputs.data(), predecessorOutputs.size(), m_patches.data());
+                loadWindows();
+
                 std::array< Var, size() > dotProducts;
-                auto& self = *this;
-                Internal::for_each([&](auto i, auto&) {
-                    Var dot = biases[i.value];
-                    for (std::size_t j = 0; j < neuronInputs; ++j) {
-                        dot += self[i.value][j].value * weights[i.value * neuronInputs + j];
+                for(std::size_t w = 0; w < size(); ++w) {
+                    dotProducts[w] = biases[w]
+                                     + math::dot(weights.data() + w * neuronInputs,
+                                                 m_patches.data() + w * neuronInputs,
+                                                 neuronInputs);
+                }
+                activate(dotProducts, myOutputs.data());
+            }
+
+            /**
+             * Calculates the outputs for a batch of samples. The patches of
+             * all samples are lowered into one matrix, ordered by window and
+             * then by sample, so the dot products of a window for the whole
+             * batch are a single matrix vector product.
+             */
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename... W >
+                requires(sizeof...(W) < 2 && weighted)
+            void calculateBatchOutputs(Context& ctx, std::size_t batchSize, const W&... wctx) {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                const auto predSize = predecessorOutputs.size() / batchSize;
+
+                m_batchPatches.resize(size() * batchSize * neuronInputs);
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    Grid::im2col(predecessorOutputs.data() + sample * predSize,
+                                 predSize,
+                                 m_batchPatches.data() + sample * neuronInputs,
+                                 batchSize * neuronInputs);
+                }
+
+                const auto [weights, biases] = parameters< myIdx >(wctx...);
+                m_batchDotProducts.resize(batchSize);
+                for(std::size_t w = 0; w < size(); ++w) {
+                    math::gemv(math::Transpose::No,
+                               batchSize,
+                               neuronInputs,
+                               Var{1},
+                               m_batchPatches.data() + w * batchSize * neuronInputs,
+                               neuronInputs,
+                               weights + w * neuronInputs,
+                               Var{0},
+                               m_batchDotProducts.data());
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        myOutputs[sample * size() + w] = m_batchDotProducts[sample] + biases[w];
                     }
-                    dotProducts[i.value] = dot;
-                });
+                }
+
+                std::array< Var, size() > dotProducts;
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    Var* row = myOutputs.data() + sample * size();
+                    std::copy_n(row, size(), dotProducts.begin());
+                    activate(dotProducts, row);
+                }
+            }
+
+          private:
+            /// @brief pooling neurons calculate their outputs from their own
+            /// copy of the window.
+            void loadWindows() {
+                if constexpr(!weighted) {
+                    Internal::for_each([&](auto i, auto& neuron) {
+                        for(std::size_t j = 0; j < neuronInputs; ++j) {
+                            neuron.setInput(j, m_patches[i.value * neuronInputs + j]);
+                        }
+                    });
+                }
+            }
+
+            void activate(const std::array< Var, size() >& dotProducts, Var* outputs) {
                 Internal::for_each([&](auto i, auto& neuron) {
-                    const auto output = neuron.calculateOutput(
-                     dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
-                    myOutputs[i.value] = output;
+                    outputs[i.value] =
+                     neuron.calculateOutput(dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
                 });
             }
+
+            /// @brief the weights and biases of the back propagation context,
+            /// the ones of the neurons if there is none.
+            template< std::size_t myIdx, typename... W >
+            std::pair< const Var*, const Var* > parameters(const W&... wctx) {
+                if constexpr(sizeof...(W) == 1) {
+                    return {std::get< myIdx >(wctx.weights).data()..., std::get< myIdx >(wctx.biases).data()...};
+                } else {
+                    m_parameters.resize(size() * (neuronInputs + 1));
+                    Var* biases = m_parameters.data() + size() * neuronInputs;
+                    Internal::for_each([&](auto i, auto& neuron) {
+                        for(std::size_t j = 0; j < neuronInputs; ++j) {
+                            m_parameters[i.value * neuronInputs + j] = neuron.getWeight(j);
+                        }
+                        biases[i.value] = neuron.getBias();
+                    });
+                    return {m_parameters.data(), biases};
+                }
+            }
+
+            Patches m_patches{};
+            std::vector< Var > m_batchPatches;
+            std::vector< Var > m_batchDotProducts;
+            std::vector< Var > m_parameters;
         };
     } // namespace detail
 
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
+#include "NeuralNetwork/Math/Fft.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace nn::detail {
+
+    /**
+     * Convolution in the frequency domain for large kernels. Every window
+     * output is a value of the cross-correlation of the grid and the
+     * kernel, so the outputs of a channel are the inverse transform of
+     * sum over input channels of X[c] * conj(K[o][c]), sampled with the
+     * stride of the kernel. The grid is padded with zeros to rows x cols,
+     * large enough for the correlation not to wrap around, and rounded up
+     * to a size of the fft. The spectra of the kernels are kept until the
+     * kernels change.
+     * The windows, the zero padding at the right and bottom border and the
+     * layouts of the inputs, outputs and kernels are the ones of
+     * SharedConvolutionLayer.
+     */
+    template< typename Var, typename Grid, std::size_t channels, std::size_t inputChannels, Layout layout >
+    class FftConvolution {
+        using K = typename Grid::K;
+        using Complex = std::complex< Var >;
+
+        static constexpr std::size_t width = Grid::width;
+        static constexpr std::size_t height = Grid::height;
+        static constexpr std::size_t rows = math::fftSize(height + K::height - 1);
+        static constexpr std::size_t cols = math::fftSize(width + K::width - 1);
+        static constexpr std::size_t points = rows * cols;
+        static constexpr std::size_t kernelSize = K::size;
+        static constexpr std::size_t weights = channels * inputChannels * kernelSize;
+
+        static constexpr std::size_t log2(std::size_t n) {
+            std::size_t result = 0;
+            for(; (std::size_t{1} << result) < n; ++result) {
+            }
+            return result;
+        }
+
+      public:
+        /// @brief multiplications of the direct convolution and of the
+        /// transforms and the products of the spectra, roughly.
+        static constexpr std::size_t directCost = Grid::framesNumber * kernelSize * inputChannels * channels;
+        static constexpr std::size_t fftCost =
+         (inputChannels + channels) * points * log2(points) * 2 + channels * inputChannels * points * 4;
+
+        static constexpr bool applicable =
+         (std::is_same_v< Var, float > || std::is_same_v< Var, double >) && fftCost < directCost;
+
+        FftConvolution()
+         : m_rowPlan(cols)
+         , m_colPlan(rows) {
+        }
+
+        /// @brief the spectra of the kernels, calculated only if the
+        /// kernels differ from the ones of the last call.
+        /// @param kernels row-major (channels x inputChannels * K::size) matrix.
+        void transformKernels(const Var* kernels) {
+            if(!m_spectra.empty() && std::equal(m_kernels.begin(), m_kernels.end(), kernels)) {
+                return;
+            }
+            m_kernels.assign(kernels, kernels + weights);
+            m_spectra.assign(channels * inputChannels * points, Complex{});
+
+            // conjugated and scaled by the 1 / points the inverse transform omits
+            const Var scale = Var{1} / static_cast< Var >(points);
+            for(std::size_t o = 0; o < channels; ++o) {
+                for(std::size_t c = 0; c < inputChannels; ++c) {
+                    Complex* spectrum = m_spectra.data() + (o * inputChannels + c) * points;
+                    for(std::size_t local = 0; local < kernelSize; ++local) {
+                        const auto y = local / K::width, x = local % K::width;
+                        spectrum[y * cols + x] = kernels[o * inputChannels * kernelSize + column(c, local)] * scale;
+                    }
+                    transform(spectrum, K::height);
+                    for(std::size_t i = 0; i < points; ++i) {
+                        spectrum[i] = std::conj(spectrum[i]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Calculates the outputs of the layer with the kernels of the last
+         * transformKernels call.
+         * @param count the number of inputs, the missing ones are zero.
+         */
+        void convolve(const Var* in, std::size_t count, const Var* biases, Var* out) {
+            m_inputs.assign(inputChannels * points, Complex{});
+            for(std::size_t c = 0; c < inputChannels; ++c) {
+                Complex* spectrum = m_inputs.data() + c * points;
+                for(std::size_t y = 0; y < height; ++y) {
+                    for(std::size_t x = 0; x < width; ++x) {
+                        const auto i = input(c, y, x);
+                        spectrum[y * cols + x] = i < count ? in[i] : Var{};
+                    }
+                }
+                transform(spectrum, height);
+            }
+
+            m_products.resize(points);
+            for(std::size_t o = 0; o < channels; ++o) {
+                const Complex* kernel = m_spectra.data() + o * inputChannels * points;
+                std::fill(m_products.begin(), m_products.end(), Complex{});
+                for(std::size_t c = 0; c < inputChannels; ++c) {
+                    const Complex* spectrum = m_inputs.data() + c * points;
+                    for(std::size_t i = 0; i < points; ++i) {
+                        m_products[i] += math::detail::multiply(spectrum[i], kernel[c * points + i]);
+                    }
+                }
+
+                // all columns, but only the rows of the windows
+                for(std::size_t x = 0; x < cols; ++x) {
+                    math::fft(m_colPlan, math::Direction::Inverse, m_products.data() + x, cols, scratch());
+                }
+                for(std::size_t wy = 0; wy < Grid::windowsPerCol; ++wy) {
+                    Complex* row = m_products.data() + wy * K::stride * cols;
+                    math::fft(m_rowPlan, math::Direction::Inverse, row, 1, scratch());
+                    for(std::size_t wx = 0; wx < Grid::windowsPerRow; ++wx) {
+                        out[output(o, wy * Grid::windowsPerRow + wx)] = row[wx * K::stride].real() + biases[o];
+                    }
+                }
+            }
+        }
+
+      private:
+        static constexpr std::size_t column(std::size_t channel, std::size_t local) {
+            return layout == Layout::NHWC ? local * inputChannels + channel : channel * kernelSize + local;
+        }
+
+        static constexpr std::size_t input(std::size_t channel, std::size_t y, std::size_t x) {
+            return layout == Layout::NHWC ? (y * width + x) * inputChannels + channel
+                                          : channel * Grid::size + y * width + x;
+        }
+
+        static constexpr std::size_t output(std::size_t channel, std::size_t window) {
+            return layout == Layout::NHWC ? window * channels + channel : channel * Grid::framesNumber + window;
+        }
+
+        /// @brief 2d transform of rows x cols values whose rows from used
+        /// on are zero and stay zero after the row transforms.
+        void transform(Complex* values, std::size_t used) {
+            for(std::size_t y = 0; y < used; ++y) {
+                math::fft(m_rowPlan, math::Direction::Forward, values + y * cols, 1, scratch());
+            }
+            for(std::size_t x = 0; x < cols; ++x) {
+                math::fft(m_colPlan, math::Direction::Forward, values + x, cols, scratch());
+            }
+        }
+
+        Complex* scratch() {
+            m_scratch.resize(2 * std::max(rows, cols));
+            return m_scratch.data();
+        }
+
+        math::FftPlan< Var > m_rowPlan;
+        math::FftPlan< Var > m_colPlan;
+        std::vector< Var > m_kernels;
+        std::vector< Complex > m_spectra;
+        std::vector< Complex > m_inputs;
+        std::vector< Complex > m_products;
+        std::vector< Complex > m_scratch;
+    };
+} // namespace nn::detail
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "NeuralNetwork/NeuralLayer/Container.h"
+#include "NeuralNetwork/Neuron/Input.h"
+#include "NeuralNetwork/Math/Dot.h"
+#include "NeuralNetwork/Math/Gemm.h"
+#include "NeuralNetwork/Math/Half.h"
+
+#include <MPL/Algorithm.h>
+#include <System/Time.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace nn {
+    namespace detail {
+        /// @brief layer storage which keeps the weights of all neurons in
+        /// one contiguous row-major matrix (size() x inputs()) and the biases
+        /// in a separate vector, instead of per neuron Input{weight, value}
+        /// arrays.
+        /// @tparam Storage type the weights are stored as, e.g.
+        /// math::float16 or math::bfloat16. void keeps the type of the neuron.
+        template< typename Neuron, std::size_t sz, typename Storage = void >
+        struct Matrix {
+            static constexpr auto size() {
+                return sz;
+            }
+        };
+
+        /// @brief reference to a single input of a neuron stored in a
+        /// matrix layer. Mimics nn::Input so neurons can be accessed in the
+        /// same way as for the other layer storages.
+        template< typename Var, typename Weight = Var >
+        struct InputRef {
+            Weight& weight;
+            Var& value;
+
+            InputRef& operator=(const nn::Input< Var >& input) {
+                weight = input.weight;
+                value = input.value;
+                return *this;
+            }
+
+            InputRef& operator=(const InputRef& input) {
+                weight = input.weight;
+                value = input.value;
+                return *this;
+            }
+
+            operator nn::Input< Var >() const {
+                return {weight, value};
+            }
+        };
+
+        /// @brief view of a single row of the matrix layer. Provides the
+        /// neuron interface on top of the layer owned storage.
+        template< typename NeuronType, typename Weight = typename NeuronType::Var >
+        struct MatrixNeuron {
+            using OutputFunction = typename NeuronType::OutputFunction;
+            using Var = typename NeuronType::Var;
+            using Input = InputRef< Var, Weight >;
+
+            static constexpr auto size() {
+                return NeuronType::size();
+            }
+
+            void bind(Weight* weights, Var* values, Var* bias, Var* output) {
+                m_weights = weights;
+                m_values = values;
+                m_bias = bias;
+                m_output = output;
+            }
+
+            Input operator[](std::size_t id) {
+                return {m_weights[id], m_values[id]};
+            }
+
+            nn::Input< Var > operator[](std::size_t id) const {
+                return {m_weights[id], m_values[id]};
+            }
+
+            void setWeight(std::size_t weightId, const Var& weight) {
+                m_weights[weightId] = weight;
+            }
+
+            Var getWeight(std::size_t weightId) const {
+                return m_weights[weightId];
+            }
+
+            const Var& getBias() const {
+                return *m_bias;
+            }
+
+            void setBias(Var weight) {
+                *m_bias = weight;
+            }
+
+            void setInput(unsigned int inputId, const Var& value) {
+                m_values[inputId] = value;
+            }
+
+            const Var& getOutput() const {
+                return *m_output;
+            }
+
+            void setOutput(const Var& output) {
+                *m_output = output;
+            }
+
+            Var calcDotProduct() const {
+                return calcDotProduct(m_values, size());
+            }
+
+            Var calcDotProduct(const Var* inputs, std::size_t count) const {
+                return *m_bias + math::dot(m_weights, inputs, count);
+            }
+
+            template< typename Iterator >
+            const Var& calculateOutput(const Var& dotProduct, Iterator begin, Iterator end) {
+                *m_output = m_activationFunction.calculate(dotProduct, begin, end);
+                return *m_output;
+            }
+
+            /// @brief the same output as calculateOutput, but not stored, with
+            /// the activation function of this neuron.
+            template< typename Iterator >
+            Var calculateOutput(const Var& dotProduct, Iterator begin, Iterator end) const {
+                return m_activationFunction.calculate(dotProduct, begin, end);
+            }
+
+          private:
+            OutputFunction m_activationFunction;
+            Weight* m_weights = nullptr;
+            Var* m_values = nullptr;
+            Var* m_bias = nullptr;
+            Var* m_output = nullptr;
+        };
+
+        template< typename T, std::size_t sz, typename Storage >
+        struct Layer< detail::Matrix< T, sz, Storage > > {
+          public:
+            using Neuron = T;
+            using Var = typename Neuron::Var;
+            using Weight = std::conditional_t< std::is_void_v< Storage >, Var, Storage >;
+            using OutputFunction = typename Neuron::OutputFunction;
+            using ActivationFunctions = std::tuple< OutputFunction >;
+            using Container = std::array< MatrixNeuron< Neuron, Weight >, sz >;
+
+            static constexpr auto inputs() {
+                return Neuron::size();
+            }
+
+            static constexpr auto size() {
+                return sz;
+            }
+
+            static_assert(std::is_same_v< Weight, Var > || std::is_same_v< Var, float >,
+                          "weights stored in half precision are calculated in float");
+
+            /// @brief same layout as the weights of the layer in bp::BPContext
+            using Weights = std::array< Weight, sz * inputs() >;
+            using Biases = std::array< Var, sz >;
+
+            template< template< class > typename L, template< class > class NewType >
+            using wrap_neuron = L< Matrix< NewType< Neuron >, sz, Storage > >;
+
+            template< template< class > typename L, std::size_t inputs >
+            using adjust_inputs =
+             L< Matrix< typename Neuron::template resize< inputs >, sz, Storage > >;
+
+            template< template< class > typename L, typename V >
+            using use_var = L< Matrix< typename Neuron::template use< V >, sz, Storage > >;
+
+            template< typename NewNeuron >
+            using with_neuron =
+             detail::NeuralLayer< Matrix< typename NewNeuron::template resize< Neuron::size() >, sz, Storage > >;
+
+            Layer() {
+                for(auto& weight : m_weights) {
+                    weight = utils::createRandom< Var >(1) / Var{100.f};
+                }
+                for(auto& bias : m_biases) {
+                    bias = utils::createRandom< Var >(1);
+                }
+                bind();
+            }
+
+            Layer(const Layer& other)
+             : m_weights(other.m_weights)
+             , m_values(other.m_values)
+             , m_biases(other.m_biases)
+             , m_outputs(other.m_outputs) {
+                bind();
+            }
+
+            Layer& operator=(const Layer& other) {
+                m_weights = other.m_weights;
+                m_values = other.m_values;
+                m_biases = other.m_biases;
+                m_outputs = other.m_outputs;
+                return *this;
+            }
+
+            const auto& operator[](unsigned int id) const {
+                return m_neurons[id];
+            }
+
+            auto& operator[](unsigned int id) {
+                return m_neurons[id];
+            }
+
+            auto cbegin() const {
+                return std::cbegin(m_neurons);
+            }
+
+            auto cend() const {
+                return std::cend(m_neurons);
+            }
+
+            auto begin() {
+                return std::begin(m_neurons);
+            }
+
+            auto end() {
+                return std::end(m_neurons);
+            }
+
+            Weights& weights() {
+                return m_weights;
+            }
+
+            const Weights& weights() const {
+                return m_weights;
+            }
+
+            Biases& biases() {
+                return m_biases;
+            }
+
+            const Biases& biases() const {
+                return m_biases;
+            }
+
+            /// @brief calculates the dot products of all neurons against the
+            /// given inputs (W * inputs + b) in one pass over the weights.
+            void calcDotProducts(const Var* values, std::size_t count, Var* out) const {
+                std::copy(m_biases.begin(), m_biases.end(), out);
+                math::gemv(math::Transpose::No, sz, count, Var{1}, m_weights.data(), inputs(), values, Var{1}, out);
+            }
+
+            /// @brief calculates the dot products of all neurons against
+            /// their own inputs.
+            void calcDotProducts(Var* out) const {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    const Weight* row = m_weights.data() + i * inputs();
+                    const Var* values = m_values.data() + i * inputs();
+                    out[i] = m_biases[i] + math::dot(row, values, inputs());
+                }
+            }
+
+            /// @brief stores the outputs calculated for the whole layer.
+            void setOutputs(const Var* outputs) {
+                std::copy_n(outputs, sz, m_outputs.begin());
+            }
+
+            /// @brief calculates the dot products of all neurons for a batch
+            /// of samples stored row by row with the given stride, as a
+            /// product of the samples and the transposed weight matrix.
+            void calcBatchDotProducts(const Var* values,
+                                      std::size_t stride,
+                                      std::size_t count,
+                                      Var* out,
+                                      std::size_t batchSize) const {
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    std::copy(m_biases.begin(), m_biases.end(), out + sample * sz);
+                }
+                math::gemm(math::Transpose::No,
+                           math::Transpose::Yes,
+                           batchSize,
+                           sz,
+                           count,
+                           Var{1},
+                           values,
+                           stride,
+                           m_weights.data(),
+                           inputs(),
+                           Var{1},
+                           out,
+                           sz);
+            }
+
+          private:
+            void bind() {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    m_neurons[i].bind(m_weights.data() + i * inputs(),
+                                      m_values.data() + i * inputs(),
+                                      m_biases.data() + i,
+                                      m_outputs.data() + i);
+                }
+            }
+
+            alignas(64) Weights m_weights;
+            alignas(64) std::array< Var, sz * inputs() > m_values{};
+            Biases m_biases;
+            Biases m_outputs{};
+
+          protected:
+            Container m_neurons;
+        };
+
+    } // namespace detail
+} // namespace nn
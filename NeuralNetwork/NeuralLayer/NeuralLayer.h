@@ -1,12 +1,21 @@
 #pragma once
 
 #include "NeuralNetwork/NeuralLayer/Container.h"
+#include "NeuralNetwork/NeuralLayer/Matrix.h"
+#include "NeuralNetwork/NeuralLayer/Sparse.h"
 #include "NeuralNetwork/NeuralLayer/Vector.h"
 #include "NeuralNetwork/NeuralLayer/Tuple.h"
+#include "NeuralNetwork/Math/Gemm.h"
 
 #include <MPL/Algorithm.h>
+#include <MPL/TypeTraits.h>
 
+#include <algorithm>
 #include <array>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <type_traits>
 
 namespace nn {
 
@@ -72,18 +81,10 @@ namespace nn {
                 const auto predSize = predecessorOutputs.size();
 
                 std::array< Var, size() > dotProducts;
-                utils::for_< size() >([this, &predecessorOutputs, &dotProducts, predSize](auto i) {
-                    auto& neuron = utils::get< i.value >(m_neurons);
-                    dotProducts[i.value] =
-                     neuron.calcDotProduct(predecessorOutputs.data(),
-                                           predSize < inputCount ? predSize : inputCount);
-                });
-
-                utils::for_< size() >([this, &dotProducts, &myOutputs](auto i) {
-                    const auto output = utils::get< i.value >(m_neurons).calculateOutput(
-                     dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
-                    myOutputs[i.value] = output;
-                });
+                Base::calcDotProducts(predecessorOutputs.data(),
+                                      predSize < inputCount ? predSize : inputCount,
+                                      dotProducts.data());
+                activate(dotProducts, myOutputs.data());
             }
 
             template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename W >
@@ -97,19 +98,29 @@ namespace nn {
                                        ? predecessorOutputs.size() : neuronInputs;
 
                 std::array< Var, size() > dotProducts;
-                utils::for_< size() >([&](auto i) {
-                    Var dot = biases[i.value];
-                    for (std::size_t j = 0; j < inputSize; ++j) {
-                        dot += predecessorOutputs[j] * weights[i.value * neuronInputs + j];
-                    }
-                    dotProducts[i.value] = dot;
-                });
-
-                utils::for_< size() >([this, &dotProducts, &myOutputs](auto i) {
-                    const auto output = utils::get< i.value >(m_neurons).calculateOutput(
-                     dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
-                    myOutputs[i.value] = output;
-                });
+                if constexpr(requires(const Base& base) {
+                                 base.calcDotProducts(weights.data(),
+                                                      biases.data(),
+                                                      predecessorOutputs.data(),
+                                                      inputSize,
+                                                      dotProducts.data());
+                             }) {
+                    // the layer knows which of the weights are in use
+                    Base::calcDotProducts(
+                     weights.data(), biases.data(), predecessorOutputs.data(), inputSize, dotProducts.data());
+                } else {
+                    dotProducts = biases;
+                    math::gemv(math::Transpose::No,
+                               size(),
+                               inputSize,
+                               Var{1},
+                               weights.data(),
+                               neuronInputs,
+                               predecessorOutputs.data(),
+                               Var{1},
+                               dotProducts.data());
+                }
+                activate(dotProducts, myOutputs.data());
             }
 
             template< typename Context, std::size_t myIdx >
@@ -117,21 +128,181 @@ namespace nn {
                 auto& myOutputs = std::get< myIdx >(ctx);
 
                 std::array< Var, size() > dotProducts;
-                utils::for_< size() >([this, &dotProducts](auto i) {
-                    dotProducts[i.value] =
-                     utils::get< i.value >(m_neurons).calcDotProduct();
-                });
+                Base::calcDotProducts(dotProducts.data());
+                activate(dotProducts, myOutputs.data());
+            }
 
-                utils::for_< size() >([this, &dotProducts, &myOutputs](auto i) {
-                    const auto output = utils::get< i.value >(m_neurons).calculateOutput(
-                     dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
-                    myOutputs[i.value] = output;
-                });
+            /// @brief calculates the outputs from the values stored one
+            /// neuron after another, inputs() values per neuron. The values
+            /// are taken with the weight 1 and without the bias, the way the
+            /// input layer of the perceptron uses them. The neurons are not
+            /// modified.
+            template< typename Context, std::size_t myIdx >
+            void calculateOutputs(Context& ctx, std::span< const Var > values) {
+                auto& myOutputs = std::get< myIdx >(ctx);
+
+                std::array< Var, size() > dotProducts;
+                sumInputs(values, dotProducts);
+                activate(dotProducts, myOutputs.data());
+            }
+
+            /// @brief the const versions calculate the same outputs, but
+            /// don't store them in the neurons. One layer can be evaluated
+            /// by several threads at once, each of them with its own context.
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx >
+            void calculateOutputs(Context& ctx) const {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                constexpr auto inputCount = inputs();
+                const auto predSize = predecessorOutputs.size();
+
+                std::array< Var, size() > dotProducts;
+                Base::calcDotProducts(predecessorOutputs.data(),
+                                      predSize < inputCount ? predSize : inputCount,
+                                      dotProducts.data());
+                activate(dotProducts, myOutputs.data());
+            }
+
+            template< typename Context, std::size_t myIdx >
+            void calculateOutputs(Context& ctx, std::span< const Var > values) const {
+                auto& myOutputs = std::get< myIdx >(ctx);
+
+                std::array< Var, size() > dotProducts;
+                sumInputs(values, dotProducts);
+                activate(dotProducts, myOutputs.data());
+            }
+
+            /// @brief calculates the outputs for a batch of samples. The
+            /// context holds the outputs of each layer as a row-major
+            /// (sample x neuron) buffer.
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx >
+            void calculateBatchOutputs(Context& ctx, std::size_t batchSize) {
+                if(batchSize == 0) {
+                    return;
+                }
+
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                const auto predSize = predecessorOutputs.size() / batchSize;
+                const auto inputSize = predSize < inputs() ? predSize : inputs();
+
+                if constexpr(requires(const Base& base) {
+                                 base.calcBatchDotProducts(
+                                  predecessorOutputs.data(), predSize, inputSize, myOutputs.data(), batchSize);
+                             }) {
+                    Base::calcBatchDotProducts(
+                     predecessorOutputs.data(), predSize, inputSize, myOutputs.data(), batchSize);
+                } else {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        Base::calcDotProducts(predecessorOutputs.data() + sample * predSize,
+                                              inputSize,
+                                              myOutputs.data() + sample * size());
+                    }
+                }
+                activateBatch(myOutputs.data(), batchSize);
+            }
+
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename W >
+            void calculateBatchOutputs(Context& ctx, std::size_t batchSize, const W& wctx) {
+                if(batchSize == 0) {
+                    return;
+                }
+
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                const auto& weights = std::get< myIdx >(wctx.weights);
+                const auto& biases = std::get< myIdx >(wctx.biases);
+                const auto predSize = predecessorOutputs.size() / batchSize;
+                const auto inputSize = predSize < inputs() ? predSize : inputs();
+
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    std::copy(biases.begin(), biases.end(), myOutputs.begin() + sample * size());
+                }
+                math::gemm(math::Transpose::No,
+                           math::Transpose::Yes,
+                           batchSize,
+                           size(),
+                           inputSize,
+                           Var{1},
+                           predecessorOutputs.data(),
+                           predSize,
+                           weights.data(),
+                           inputs(),
+                           Var{1},
+                           myOutputs.data(),
+                           size());
+                activateBatch(myOutputs.data(), batchSize);
             }
 
           private:
+            using OutputFunction = std::tuple_element_t< 0, ActivationFunctions >;
+
+            /// @brief true if all neurons share one activation function which
+            /// can be applied to the whole layer at once.
+            static constexpr bool sharesActivation =
+             requires(Base& base, const OutputFunction& function, std::span< Var > values) {
+                 function.apply(std::span< const Var >(values), values);
+                 base.setOutputs(values.data());
+             };
+
+            static void sumInputs(std::span< const Var > values, std::array< Var, size() >& sums) {
+                if constexpr(inputs() == 1) {
+                    std::copy_n(values.begin(), size(), sums.begin());
+                } else {
+                    for(std::size_t i = 0; i < size(); ++i) {
+                        const auto row = values.subspan(i * inputs(), inputs());
+                        sums[i] = std::accumulate(row.begin(), row.end(), Var{});
+                    }
+                }
+            }
+
+            void activate(const std::array< Var, size() >& dotProducts, Var* outputs) const {
+                if constexpr(sharesActivation) {
+                    m_activationFunction.apply(dotProducts, std::span< Var >(outputs, size()));
+                } else {
+                    utils::for_< size() >([this, &dotProducts, outputs](auto i) {
+                        outputs[i.value] = utils::get< i.value >(m_neurons).calculateOutput(
+                         dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
+                    });
+                }
+            }
+
+            void activate(const std::array< Var, size() >& dotProducts, Var* outputs) {
+                if constexpr(sharesActivation) {
+                    m_activationFunction.apply(dotProducts, std::span< Var >(outputs, size()));
+                    Base::setOutputs(outputs);
+                } else {
+                    utils::for_< size() >([this, &dotProducts, outputs](auto i) {
+                        outputs[i.value] = utils::get< i.value >(m_neurons).calculateOutput(
+                         dotProducts[i.value], std::cbegin(dotProducts), std::cend(dotProducts));
+                    });
+                }
+            }
+
+            void activateBatch(Var* outputs, std::size_t batchSize) {
+                if constexpr(sharesActivation) {
+                    // one row at a time, functions like softmax depend on
+                    // all outputs of the layer
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        const std::span< Var > row(outputs + sample * size(), size());
+                        m_activationFunction.apply(row, row);
+                    }
+                    if(batchSize > 0) {
+                        Base::setOutputs(outputs + (batchSize - 1) * size());
+                    }
+                } else {
+                    std::array< Var, size() > dotProducts;
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        Var* row = outputs + sample * size();
+                        std::copy_n(row, size(), dotProducts.begin());
+                        activate(dotProducts, row);
+                    }
+                }
+            }
+
+            [[no_unique_address]] std::conditional_t< sharesActivation, OutputFunction, utils::empty >
+             m_activationFunction{};
             using Base::m_neurons;
-            NeuralLayer& self{*this};
         };
     } // namespace detail
 
@@ -143,6 +314,44 @@ namespace nn {
     using NeuralLayer =
      detail::NeuralLayer< nn::detail::Vector< NeuronType< ActivationFunctionType, Var, inputsNumber >, size > >;
 
+    /// @brief neural layer which keeps the weights of its neurons in one
+    /// contiguous row-major matrix. Has the same interface as NeuralLayer,
+    /// but the dot products of the whole layer are computed as a single
+    /// matrix vector product.
+    template< template< template< class > class, class, std::size_t > class NeuronType,
+              template< class > class ActivationFunctionType,
+              std::size_t size,
+              std::size_t inputsNumber = size,
+              typename Var = float >
+    using MatrixNeuralLayer =
+     detail::NeuralLayer< nn::detail::Matrix< NeuronType< ActivationFunctionType, Var, inputsNumber >, size > >;
+
+    /// @brief MatrixNeuralLayer which stores its weights in half precision
+    /// (math::float16 or math::bfloat16). The weights are converted to float
+    /// inside the kernels and all the calculations are done in float, so
+    /// only the memory traffic of the weights is halved. The default storage
+    /// is float16 where the compiler supports it and bfloat16 elsewhere.
+    template< template< template< class > class, class, std::size_t > class NeuronType,
+              template< class > class ActivationFunctionType,
+              std::size_t size,
+              std::size_t inputsNumber = size,
+              typename Storage = math::half >
+    using HalfMatrixNeuralLayer =
+     detail::NeuralLayer< nn::detail::Matrix< NeuronType< ActivationFunctionType, float, inputsNumber >, size, Storage > >;
+
+    /// @brief neural layer for pruned models which stores only the non zero
+    /// weights (compressed sparse row format). A new layer is fully
+    /// connected, prune builds the sparse weights from the weights of the
+    /// back propagation context. Used in bp::BepAlgorithm the layer keeps
+    /// the pruned weights at zero during the training.
+    template< template< template< class > class, class, std::size_t > class NeuronType,
+              template< class > class ActivationFunctionType,
+              std::size_t size,
+              std::size_t inputsNumber = size,
+              typename Var = float >
+    using SparseNeuralLayer =
+     detail::NeuralLayer< nn::detail::Sparse< NeuronType< ActivationFunctionType, Var, inputsNumber >, size > >;
+
     template< std::size_t inputs, typename Var, typename... Neuron >
     using ComplexNeuralInputLayer =
      detail::NeuralLayer< detail::Tuple< Var, inputs, typename Neuron::template resize< inputs >... > >;
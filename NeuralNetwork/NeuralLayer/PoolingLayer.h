@@ -3,38 +3,390 @@
 #include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
 #include "NeuralNetwork/Neuron/PoolingNeuron.h"
 
+#include <MPL/TypeTraits.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace nn {
 
     namespace detail {
-        template< typename Internal >
-        struct PoolingLayer : private Internal {
-            using Internal::begin;
-            using Internal::cbegin;
-            using Internal::cend;
-            using Internal::end;
-            using Internal::for_each;
-            using Internal::inputs;
-            using Internal::setInput;
-            using Internal::size;
-            using Internal::operator[];
-            using Internal::calculateOutputs;
+        /**
+         * Visits the windows of the grid. The windows of a row which lie
+         * completely inside of the grid are handed to interior(wy, columns)
+         * as the first columns windows of the row, so the kernels can loop
+         * over them without bound checks. Every other window is handed to
+         * border(w). The inputs from count on are zero, if there are
+         * missing inputs all windows are border windows.
+         */
+        template< typename Grid, typename Interior, typename Border >
+        void forEachWindow(std::size_t count, Interior interior, Border border) {
+            using K = typename Grid::K;
+            constexpr std::size_t columns =
+             Grid::width >= K::width ? std::min(Grid::windowsPerRow, (Grid::width - K::width) / K::stride + 1) : 0;
+            constexpr std::size_t rows =
+             Grid::height >= K::height ? std::min(Grid::windowsPerCol, (Grid::height - K::height) / K::stride + 1)
+                                       : 0;
+            const bool complete = count >= Grid::size;
+
+            for(std::size_t wy = 0; wy < Grid::windowsPerCol; ++wy) {
+                std::size_t first = 0;
+                if(complete && wy < rows && columns > 0) {
+                    interior(wy, columns);
+                    first = columns;
+                }
+                for(std::size_t wx = first; wx < Grid::windowsPerRow; ++wx) {
+                    border(wy * Grid::windowsPerRow + wx);
+                }
+            }
+        }
+
+        /**
+         * Pools the windows of the grid straight from the outputs of the
+         * predecessor. The parts of a window outside of the grid and the
+         * missing inputs are zero, as for the convolution. The
+         * specializations for the pooling algorithms loop over the output
+         * columns of a row or keep the tables of their algorithm, the
+         * generic one calls the algorithm for a copy of every window.
+         */
+        template< typename PoolingAlgo >
+        struct PoolingKernel {
+            template< typename Grid, typename Var >
+            void pool(const Var* in, std::size_t count, Var* out) {
+                const std::size_t limit = std::min(count, Grid::size);
+                const auto& gather = Grid::gather();
+                std::array< Var, Grid::K::size > window;
+                for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                    for(std::size_t j = 0; j < window.size(); ++j) {
+                        const auto input = gather[w * Grid::K::size + j];
+                        window[j] = input < limit ? in[input] : Var{};
+                    }
+                    out[w] = PoolingAlgo{}(window.begin(), window.end());
+                }
+            }
+        };
+
+        template< typename T >
+        struct PoolingKernel< Avg< T > > {
+            template< typename Grid, typename Var >
+            void pool(const Var* in, std::size_t count, Var* out) {
+                using K = typename Grid::K;
+                const std::size_t limit = std::min(count, Grid::size);
+                forEachWindow< Grid >(
+                 count,
+                 [&](std::size_t wy, std::size_t columns) {
+                     Var* sums = out + wy * Grid::windowsPerRow;
+                     std::fill_n(sums, columns, Var{});
+                     for(std::size_t ky = 0; ky < K::height; ++ky) {
+                         for(std::size_t kx = 0; kx < K::width; ++kx) {
+                             const Var* row = in + (wy * K::stride + ky) * Grid::width + kx;
+                             for(std::size_t wx = 0; wx < columns; ++wx) {
+                                 sums[wx] += row[wx * K::stride];
+                             }
+                         }
+                     }
+                     for(std::size_t wx = 0; wx < columns; ++wx) {
+                         sums[wx] /= static_cast< Var >(K::size);
+                     }
+                 },
+                 [&](std::size_t w) {
+                     const auto& gather = Grid::gather();
+                     Var sum{};
+                     for(std::size_t j = 0; j < K::size; ++j) {
+                         const auto input = gather[w * K::size + j];
+                         sum += input < limit ? in[input] : Var{};
+                     }
+                     out[w] = sum / static_cast< Var >(K::size);
+                 });
+            }
+        };
+
+        template< typename T >
+        struct PoolingKernel< Max< T > > {
+            /// @param argmax the input each output is taken from, the first
+            /// one of equal values. Grid::outside for the zero of a
+            /// position outside of the grid or of a missing input.
+            template< typename Grid, typename Var >
+            void pool(const Var* in, std::size_t count, Var* out, WindowIndex* argmax) {
+                using K = typename Grid::K;
+                const std::size_t limit = std::min(count, Grid::size);
+                forEachWindow< Grid >(
+                 count,
+                 [&](std::size_t wy, std::size_t columns) {
+                     Var* maxima = out + wy * Grid::windowsPerRow;
+                     WindowIndex* indices = argmax + wy * Grid::windowsPerRow;
+                     const std::size_t top = wy * K::stride * Grid::width;
+                     for(std::size_t wx = 0; wx < columns; ++wx) {
+                         maxima[wx] = in[top + wx * K::stride];
+                         indices[wx] = static_cast< WindowIndex >(top + wx * K::stride);
+                     }
+                     for(std::size_t j = 1; j < K::size; ++j) {
+                         const std::size_t first = top + (j / K::width) * Grid::width + j % K::width;
+                         const Var* row = in + first;
+                         // selects instead of branches, so the loop vectorizes
+                         for(std::size_t wx = 0; wx < columns; ++wx) {
+                             const Var value = row[wx * K::stride];
+                             const bool greater = value > maxima[wx];
+                             maxima[wx] = greater ? value : maxima[wx];
+                             indices[wx] = greater ? static_cast< WindowIndex >(first + wx * K::stride) : indices[wx];
+                         }
+                     }
+                 },
+                 [&](std::size_t w) {
+                     const auto& gather = Grid::gather();
+                     Var best{};
+                     WindowIndex index = Grid::outside;
+                     for(std::size_t j = 0; j < K::size; ++j) {
+                         const auto input = gather[w * K::size + j];
+                         const bool present = input < limit;
+                         const Var value = present ? in[input] : Var{};
+                         if(j == 0 || value > best) {
+                             best = value;
+                             index = present ? input : Grid::outside;
+                         }
+                     }
+                     out[w] = best;
+                     argmax[w] = index;
+                 });
+            }
+        };
+
+        /// @brief a value of the sliding window maximum and the input it
+        /// comes from.
+        template< typename Var >
+        struct SlidingEntry {
+            Var value;
+            WindowIndex index;
+            std::size_t position;
+        };
+
+        /**
+         * Sliding window maximum of the values at(0), at(1), ... Window w
+         * covers the positions [w * stride, w * stride + size) and
+         * emit(w, entry) gets the first maximum of it. The deque keeps the
+         * decreasing maxima of the current window, every value is pushed and
+         * popped once.
+         * @param deque room for (windows - 1) * stride + size entries.
+         */
+        template< typename Var, typename At, typename Emit >
+        void slidingMax(std::size_t windows, std::size_t size, std::size_t stride, At at, Emit emit, SlidingEntry< Var >* deque) {
+            std::size_t head = 0, tail = 0;
+            for(std::size_t w = 0, position = 0; w < windows; ++position) {
+                const auto [value, index] = at(position);
+                // equal values stay, the first one of the window wins
+                while(tail > head && deque[tail - 1].value < value) {
+                    --tail;
+                }
+                deque[tail++] = {value, index, position};
+
+                if(position == w * stride + size - 1) {
+                    while(deque[head].position < w * stride) {
+                        ++head;
+                    }
+                    emit(w, deque[head]);
+                    ++w;
+                }
+            }
+        }
+
+        /// @brief separable max pooling, the maxima of the window rows of
+        /// every grid row and then the maxima of them along the columns.
+        /// Same outputs and argmax as Max.
+        template< typename T >
+        struct PoolingKernel< SlidingMax< T > > {
+            template< typename Grid, typename Var >
+            void pool(const Var* in, std::size_t count, Var* out, WindowIndex* argmax) {
+                using K = typename Grid::K;
+                using Entry = std::pair< Var, WindowIndex >;
+                constexpr std::size_t rows = (Grid::windowsPerCol - 1) * K::stride + K::height;
+                constexpr std::size_t columns = (Grid::windowsPerRow - 1) * K::stride + K::width;
+                const std::size_t limit = std::min(count, Grid::size);
+                m_rowMaxima.resize(rows * Grid::windowsPerRow);
+                m_deque.resize(std::max(rows, columns));
+
+                for(std::size_t y = 0; y < rows; ++y) {
+                    Entry* maxima = m_rowMaxima.data() + y * Grid::windowsPerRow;
+                    if(y >= Grid::height) {
+                        std::fill_n(maxima, Grid::windowsPerRow, Entry{Var{}, Grid::outside});
+                        continue;
+                    }
+                    slidingMax(
+                     Grid::windowsPerRow,
+                     K::width,
+                     K::stride,
+                     [&](std::size_t x) {
+                         const std::size_t input = y * Grid::width + x;
+                         return x < Grid::width && input < limit ? Entry{in[input], static_cast< WindowIndex >(input)}
+                                                                 : Entry{Var{}, Grid::outside};
+                     },
+                     [&](std::size_t wx, const SlidingEntry< Var >& entry) {
+                         maxima[wx] = {entry.value, entry.index};
+                     },
+                     m_deque.data());
+                }
+
+                for(std::size_t wx = 0; wx < Grid::windowsPerRow; ++wx) {
+                    slidingMax(
+                     Grid::windowsPerCol,
+                     K::height,
+                     K::stride,
+                     [&](std::size_t y) { return m_rowMaxima[y * Grid::windowsPerRow + wx]; },
+                     [&](std::size_t wy, const SlidingEntry< Var >& entry) {
+                         out[wy * Grid::windowsPerRow + wx] = entry.value;
+                         argmax[wy * Grid::windowsPerRow + wx] = entry.index;
+                     },
+                     m_deque.data());
+                }
+            }
+
+          private:
+            std::vector< std::pair< T, WindowIndex > > m_rowMaxima;
+            std::vector< SlidingEntry< T > > m_deque;
+        };
+
+        /// @brief average pooling from a summed area table, the sum of a
+        /// window are four values of the table.
+        template< typename T >
+        struct PoolingKernel< SummedAreaAvg< T > > {
+            template< typename Grid, typename Var >
+            void pool(const Var* in, std::size_t count, Var* out) {
+                using K = typename Grid::K;
+                constexpr std::size_t stride = Grid::width + 1;
+                const std::size_t limit = std::min(count, Grid::size);
+                // the first row and column stay zero
+                m_table.resize((Grid::height + 1) * stride);
+
+                for(std::size_t y = 0; y < Grid::height; ++y) {
+                    Sum row{};
+                    for(std::size_t x = 0; x < Grid::width; ++x) {
+                        const std::size_t input = y * Grid::width + x;
+                        row += input < limit ? in[input] : Var{};
+                        m_table[(y + 1) * stride + x + 1] = m_table[y * stride + x + 1] + row;
+                    }
+                }
+
+                for(std::size_t wy = 0; wy < Grid::windowsPerCol; ++wy) {
+                    const std::size_t top = wy * K::stride;
+                    const std::size_t bottom = std::min(top + K::height, Grid::height);
+                    for(std::size_t wx = 0; wx < Grid::windowsPerRow; ++wx) {
+                        const std::size_t left = wx * K::stride;
+                        const std::size_t right = std::min(left + K::width, Grid::width);
+                        const Sum sum = m_table[bottom * stride + right] - m_table[top * stride + right]
+                                        - m_table[bottom * stride + left] + m_table[top * stride + left];
+                        out[wy * Grid::windowsPerRow + wx] = static_cast< Var >(sum / static_cast< Sum >(K::size));
+                    }
+                }
+            }
+
+          private:
+            // the differences of the large sums of a float table lose the
+            // small windows, the table is kept in double
+            using Sum = std::conditional_t< std::is_same_v< T, float >, double, T >;
+
+            std::vector< Sum > m_table;
+        };
+
+        /**
+         * Pooling layer, one output per window of the grid. The windows are
+         * read straight from the outputs of the predecessor by the kernel
+         * of the pooling algorithm. Max pooling records the input of every
+         * output, the back propagation routes the errors through it.
+         */
+        template< typename VarType, template< class > class PoolingAlgo, typename Grid >
+        class PoolingLayer {
+            using Kernel = PoolingKernel< PoolingAlgo< VarType > >;
+
+          public:
+            using Var = VarType;
+            using Input = Var;
+            using Algorithm = PoolingAlgo< Var >;
+
+            /// @brief true if the kernel records the input of every output.
+            static constexpr bool recordsArgmax =
+             requires(Kernel& kernel, const Var* in, std::size_t count, Var* out, WindowIndex* argmax) {
+                 kernel.template pool< Grid >(in, count, out, argmax);
+             };
+
+            /// @brief the input of every output of the last evaluated sample.
+            using Argmax = std::array< WindowIndex, Grid::framesNumber >;
+
+            static constexpr auto size() {
+                return Grid::framesNumber;
+            }
+
+            static constexpr auto inputs() {
+                return Grid::K::size;
+            }
+
+            /// @brief the layer has no weights and biases in the back
+            /// propagation context.
+            static constexpr std::size_t weightsNumber() {
+                return 0;
+            }
+
+            static constexpr std::size_t biasesNumber() {
+                return 0;
+            }
+
             // We can't adjust this layer as the
             // number of inputs and neurons depends
             // on the convolution grid and frame sizes
             template< unsigned int inputs >
             using adjust = PoolingLayer;
 
-            template< typename VarType >
-            using use = PoolingLayer< typename Internal::template use< VarType > >;
+            template< typename V >
+            using use = PoolingLayer< V, PoolingAlgo, Grid >;
+
+            const Argmax& argmax() const
+                requires recordsArgmax
+            {
+                return m_argmax;
+            }
+
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx >
+            void calculateOutputs(Context& ctx) {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                pool(predecessorOutputs.data(), predecessorOutputs.size(), myOutputs.data());
+            }
+
+            /// @brief the layer has no parameters, the ones of the back
+            /// propagation context are ignored.
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename W >
+            void calculateOutputs(Context& ctx, const W&) {
+                calculateOutputs< Context, myIdx, predecessorIdx >(ctx);
+            }
+
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename... W >
+                requires(sizeof...(W) < 2)
+            void calculateBatchOutputs(Context& ctx, std::size_t batchSize, const W&...) {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                const auto predSize = predecessorOutputs.size() / batchSize;
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    pool(predecessorOutputs.data() + sample * predSize, predSize, myOutputs.data() + sample * size());
+                }
+            }
+
+          private:
+            void pool(const Var* in, std::size_t count, Var* out) {
+                if constexpr(recordsArgmax) {
+                    m_kernel.template pool< Grid >(in, count, out, m_argmax.data());
+                } else {
+                    m_kernel.template pool< Grid >(in, count, out);
+                }
+            }
+
+            [[no_unique_address]] Kernel m_kernel;
+            [[no_unique_address]] std::conditional_t< recordsArgmax, Argmax, utils::empty > m_argmax{};
         };
     } // namespace detail
 
-    template< template< template< template< class > class, class, std::size_t > class, template< class > class, std::size_t size, std::size_t inputsNumber, typename Var = float >
-              typename NeuralLayerType,
-              template< class >
-              class PoolingAlgo,
-              typename Grid,
-              typename Var = float >
-    using PoolingLayer = detail::PoolingLayer<
-     detail::ConvolutionLayer< NeuralLayerType< PoolingNeuron, PoolingAlgo, Grid::framesNumber, Grid::K::size >, Grid > >;
+    template< template< class > class PoolingAlgo, typename Grid, typename Var = float >
+    using PoolingLayer = detail::PoolingLayer< Var, PoolingAlgo, Grid >;
 } // namespace nn
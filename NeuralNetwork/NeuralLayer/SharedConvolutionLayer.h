@@ -0,0 +1,431 @@
+#pragma once
+
+#include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
+#include "NeuralNetwork/NeuralLayer/FftConvolution.h"
+#include "NeuralNetwork/NeuralLayer/Winograd.h"
+#include "NeuralNetwork/Math/Gemm.h"
+
+#include <MPL/TypeTraits.h>
+#include <System/Time.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace nn {
+    namespace detail {
+        /**
+         * Convolution layer whose windows share one kernel per output
+         * channel, so the layer has channels * inputChannels * K::size
+         * weights whatever the size of the grid. The inputs and the outputs
+         * are stored in the given layout, the outputs of NHWC window by
+         * window with the channels of a window next to each other. The
+         * windows are lowered into a patch matrix (windows x inputs()) and
+         * the outputs of all windows and channels are a single matrix
+         * product of the patches and the kernels. The kernels are a
+         * row-major (channels x inputs()) matrix whose rows are ordered as
+         * the rows of the patch matrix: input channel after input channel
+         * for NCHW, the input channels of a kernel position next to each
+         * other for NHWC. A 3x3 kernel with stride 1 is calculated with the
+         * Winograd transform instead of the patch matrix, kernels large
+         * enough for the transforms to cost less than the matrix product
+         * in the frequency domain.
+         */
+        template< typename OutputFunctionType,
+                  typename Grid,
+                  std::size_t channels,
+                  std::size_t inputChannels = 1,
+                  Layout layout = Layout::NHWC >
+        class SharedConvolutionLayer {
+            static_assert(channels > 0 && inputChannels > 0, "at least one channel is needed");
+
+            static constexpr auto kernelSize = Grid::K::size;
+            static constexpr auto windows = Grid::framesNumber;
+            static constexpr auto patchSize = inputChannels * kernelSize;
+
+          public:
+            using OutputFunction = OutputFunctionType;
+            using Var = typename OutputFunction::Var;
+
+          protected:
+            using Winograd = WinogradConvolution< Var, Grid, channels, inputChannels, layout >;
+            using Fft = FftConvolution< Var, Grid, channels, inputChannels, layout >;
+
+            /// @brief a 1x1 kernel with stride 1 needs no lowering, the
+            /// inputs already are the patch matrix (transposed for NCHW).
+            static constexpr bool pointwise = Grid::K::width == 1 && Grid::K::height == 1 && Grid::K::stride == 1;
+
+            /// @brief the forward pass doesn't lower the inputs, the patch
+            /// matrix is built for the back propagation only.
+            static constexpr bool winograd = Winograd::applicable;
+            static constexpr bool fft = !winograd && Fft::applicable;
+
+          public:
+            using ActivationFunctions = std::tuple< OutputFunction >;
+            using Input = Var;
+
+            /// @brief row-major (channels x inputs()) matrix, one kernel per row.
+            using Kernels = std::array< Var, channels * patchSize >;
+            using Biases = std::array< Var, channels >;
+
+            /// @brief the windows of the last evaluated sample, one row of
+            /// inputs() values per window.
+            using Patches = std::array< Var, windows * patchSize >;
+
+            /// @brief the patch matrix used by the last evaluation. A
+            /// pointwise convolution reads the outputs of the predecessor in
+            /// place, for NCHW they are the transposed patch matrix.
+            struct Lowered {
+                const Var* data;
+                math::Transpose trans;
+                std::size_t ld;
+            };
+
+            static constexpr auto size() {
+                return windows * channels;
+            }
+
+            static constexpr auto inputs() {
+                return patchSize;
+            }
+
+            /// @brief the number of weights and biases the back propagation
+            /// context keeps for the layer.
+            static constexpr auto weightsNumber() {
+                return channels * patchSize;
+            }
+
+            static constexpr auto biasesNumber() {
+                return channels;
+            }
+
+            // the number of inputs depends on the grid only
+            template< unsigned int inputs >
+            using adjust = SharedConvolutionLayer;
+
+            template< typename VarType >
+            using use = SharedConvolutionLayer< typename OutputFunction::template use< VarType >,
+                                                Grid,
+                                                channels,
+                                                inputChannels,
+                                                layout >;
+
+            template< typename NewNeuron >
+            using with_neuron = SharedConvolutionLayer< typename NewNeuron::OutputFunction::template use< Var >,
+                                                        Grid,
+                                                        channels,
+                                                        inputChannels,
+                                                        layout >;
+
+            SharedConvolutionLayer() {
+                for(auto& weight : m_kernels) {
+                    weight = utils::createRandom< Var >(1) / Var{100.f};
+                }
+                for(auto& bias : m_biases) {
+                    bias = utils::createRandom< Var >(1);
+                }
+            }
+
+            SharedConvolutionLayer(const SharedConvolutionLayer& other)
+             : m_kernels(other.m_kernels)
+             , m_biases(other.m_biases)
+             , m_patches(other.m_patches) {
+            }
+
+            SharedConvolutionLayer& operator=(const SharedConvolutionLayer& other) {
+                m_kernels = other.m_kernels;
+                m_biases = other.m_biases;
+                m_patches = other.m_patches;
+                m_lowered = {m_patches.data(), math::Transpose::No, patchSize};
+                return *this;
+            }
+
+            Kernels& kernels() {
+                return m_kernels;
+            }
+
+            const Kernels& kernels() const {
+                return m_kernels;
+            }
+
+            Biases& biases() {
+                return m_biases;
+            }
+
+            const Biases& biases() const {
+                return m_biases;
+            }
+
+            const Patches& patches() const {
+                return m_patches;
+            }
+
+            const Lowered& lowered() const {
+                return m_lowered;
+            }
+
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx >
+            void calculateOutputs(Context& ctx) {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                prepare(m_kernels.data());
+                forward(predecessorOutputs.data(), predecessorOutputs.size(), m_kernels.data(), m_biases.data(), myOutputs.data());
+                activate(myOutputs.data(), 1);
+            }
+
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename W >
+            void calculateOutputs(Context& ctx, const W& wctx) {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                const auto& kernels = std::get< myIdx >(wctx.weights);
+                prepare(kernels.data());
+                forward(predecessorOutputs.data(),
+                        predecessorOutputs.size(),
+                        kernels.data(),
+                        std::get< myIdx >(wctx.biases).data(),
+                        myOutputs.data());
+                activate(myOutputs.data(), 1);
+            }
+
+            /// @brief the patches of all samples are stacked into one matrix,
+            /// the outputs of the batch are a single matrix product for NHWC
+            /// and one per sample for NCHW, the Winograd transform and the
+            /// fft.
+            template< typename Context, std::size_t myIdx, std::size_t predecessorIdx, typename... W >
+                requires(sizeof...(W) < 2)
+            void calculateBatchOutputs(Context& ctx, std::size_t batchSize, const W&... wctx) {
+                const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+                auto& myOutputs = std::get< myIdx >(ctx);
+                const auto predSize = predecessorOutputs.size() / batchSize;
+
+                const Var* kernels = m_kernels.data();
+                const Var* biases = m_biases.data();
+                if constexpr(sizeof...(W) == 1) {
+                    kernels = (std::get< myIdx >(wctx.weights).data(), ...);
+                    biases = (std::get< myIdx >(wctx.biases).data(), ...);
+                }
+
+                prepare(kernels);
+                if constexpr(layout == Layout::NHWC && !winograd && !fft) {
+                    if(pointwise && predSize == windows * inputChannels) {
+                        // the samples follow each other, so do their rows
+                        const Lowered inputs{predecessorOutputs.data(), math::Transpose::No, inputChannels};
+                        convolve(inputs, batchSize, kernels, biases, myOutputs.data());
+                        activate(myOutputs.data(), batchSize);
+                        return;
+                    }
+                    m_batchPatches.resize(batchSize * m_patches.size());
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        lower(predecessorOutputs.data() + sample * predSize,
+                              predSize,
+                              m_batchPatches.data() + sample * m_patches.size());
+                    }
+                    convolve({m_batchPatches.data(), math::Transpose::No, patchSize},
+                             batchSize,
+                             kernels,
+                             biases,
+                             myOutputs.data());
+                } else {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        forward(predecessorOutputs.data() + sample * predSize,
+                                predSize,
+                                kernels,
+                                biases,
+                                myOutputs.data() + sample * size());
+                    }
+                }
+                activate(myOutputs.data(), batchSize);
+            }
+
+          protected:
+            /// @brief the patch matrix of the given inputs of the last
+            /// evaluation, lowered now if the evaluation didn't need it.
+            const Lowered& lowered(const Var* in, std::size_t count) {
+                if constexpr(winograd || fft) {
+                    m_lowered = lower(in, count, m_patches.data());
+                }
+                return m_lowered;
+            }
+
+            /**
+             * Lowers the windows of all input channels into the patch
+             * matrix. The inputs from count on are zero.
+             * @return the patch matrix, the inputs themselves for a
+             * pointwise convolution.
+             */
+            static Lowered lower(const Var* in, std::size_t count, Var* patches) {
+                if constexpr(pointwise) {
+                    if(count >= windows * inputChannels) {
+                        if constexpr(layout == Layout::NHWC) {
+                            return {in, math::Transpose::No, inputChannels};
+                        } else {
+                            return {in, math::Transpose::Yes, windows};
+                        }
+                    }
+                }
+
+                if constexpr(inputChannels == 1) {
+                    Grid::im2col(in, count, patches);
+                } else if constexpr(layout == Layout::NCHW) {
+                    for(std::size_t c = 0; c < inputChannels; ++c) {
+                        const std::size_t offset = c * Grid::size;
+                        const std::size_t available = count > offset ? std::min(count - offset, Grid::size) : 0;
+                        Grid::im2col(available > 0 ? in + offset : in, available, patches + c * kernelSize, patchSize);
+                    }
+                } else {
+                    const std::size_t limit = std::min(count, Grid::size * inputChannels);
+                    const auto& gather = Grid::gather();
+                    for(std::size_t j = 0; j < windows * kernelSize; ++j) {
+                        const std::size_t first = std::size_t{gather[j]} * inputChannels;
+                        for(std::size_t c = 0; c < inputChannels; ++c) {
+                            patches[j * inputChannels + c] = first + c < limit ? in[first + c] : Var{};
+                        }
+                    }
+                }
+                return {patches, math::Transpose::No, patchSize};
+            }
+
+            /**
+             * The transposed lowering, every input collects the errors of
+             * the window positions it belongs to.
+             * @param errors row-major (windows x inputs()) matrix.
+             */
+            static void col2im(const Var* errors, Var* out, std::size_t count) {
+                if constexpr(inputChannels == 1) {
+                    Grid::col2im(errors, out, count);
+                } else {
+                    std::fill_n(out, count, Var{});
+                    const std::size_t limit = std::min(count, Grid::size * inputChannels);
+                    const auto& offsets = Grid::scatterOffsets();
+                    const auto& scatter = Grid::scatter();
+                    for(std::size_t i = 0; i < Grid::size; ++i) {
+                        for(auto s = offsets[i]; s < offsets[i + 1]; ++s) {
+                            const auto [window, local] = scatter[s];
+                            for(std::size_t c = 0; c < inputChannels; ++c) {
+                                if constexpr(layout == Layout::NCHW) {
+                                    if(c * Grid::size + i < limit) {
+                                        out[c * Grid::size + i] += errors[window * patchSize + c * kernelSize + local];
+                                    }
+                                } else {
+                                    if(i * inputChannels + c < limit) {
+                                        out[i * inputChannels + c] += errors[window * patchSize + local * inputChannels + c];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+          private:
+            /// @brief the Winograd transform of the kernels is calculated
+            /// once per evaluation, the kernels of the context change with
+            /// every training step. The fft keeps the spectra while the
+            /// kernels stay the same.
+            void prepare(const Var* kernels) {
+                if constexpr(winograd) {
+                    m_winograd.transformKernels(kernels);
+                } else if constexpr(fft) {
+                    m_fft.transformKernels(kernels);
+                }
+            }
+
+            /// @brief the outputs of one sample.
+            void forward(const Var* in, std::size_t count, const Var* kernels, const Var* biases, Var* out) {
+                if constexpr(winograd) {
+                    m_winograd.convolve(in, count, biases, out);
+                } else if constexpr(fft) {
+                    m_fft.convolve(in, count, biases, out);
+                } else {
+                    m_lowered = lower(in, count, m_patches.data());
+                    convolve(m_lowered, 1, kernels, biases, out);
+                }
+            }
+
+            /// @brief outputs = patches * kernels^T + biases in the layout
+            /// of the layer, for batchSize samples whose patches follow each
+            /// other.
+            static void convolve(const Lowered& patches,
+                                 std::size_t batchSize,
+                                 const Var* kernels,
+                                 const Var* biases,
+                                 Var* out) {
+                if constexpr(layout == Layout::NHWC) {
+                    const auto rows = batchSize * windows;
+                    for(std::size_t w = 0; w < rows; ++w) {
+                        std::copy_n(biases, channels, out + w * channels);
+                    }
+                    if(channels == 1 && patches.trans == math::Transpose::No) {
+                        math::gemv(math::Transpose::No, rows, patchSize, Var{1}, patches.data, patches.ld, kernels, Var{1}, out);
+                    } else {
+                        math::gemm(patches.trans,
+                                   math::Transpose::Yes,
+                                   rows,
+                                   channels,
+                                   patchSize,
+                                   Var{1},
+                                   patches.data,
+                                   patches.ld,
+                                   kernels,
+                                   patchSize,
+                                   Var{1},
+                                   out,
+                                   channels);
+                    }
+                } else {
+                    // one (channels x windows) matrix, kernels * patches^T
+                    for(std::size_t c = 0; c < channels; ++c) {
+                        std::fill_n(out + c * windows, windows, biases[c]);
+                    }
+                    math::gemm(math::Transpose::No,
+                               patches.trans == math::Transpose::No ? math::Transpose::Yes : math::Transpose::No,
+                               channels,
+                               windows,
+                               patchSize,
+                               Var{1},
+                               kernels,
+                               patchSize,
+                               patches.data,
+                               patches.ld,
+                               Var{1},
+                               out,
+                               windows);
+                }
+            }
+
+            /// @brief one sample at a time, functions like softmax depend on
+            /// all outputs of the layer.
+            void activate(Var* outputs, std::size_t batchSize) const {
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    const std::span< Var > row(outputs + sample * size(), size());
+                    m_activationFunction.apply(row, row);
+                }
+            }
+
+            Kernels m_kernels;
+            Biases m_biases;
+            Patches m_patches{};
+            Lowered m_lowered{m_patches.data(), math::Transpose::No, patchSize};
+            std::vector< Var > m_batchPatches;
+            [[no_unique_address]] std::conditional_t< winograd, Winograd, utils::empty > m_winograd;
+            [[no_unique_address]] std::conditional_t< fft, Fft, utils::empty > m_fft;
+            OutputFunction m_activationFunction{};
+        };
+    } // namespace detail
+
+    /// @brief convolution layer with channels kernels of Grid::K, each of
+    /// them shared by all windows of the grid, over inputChannels input
+    /// channels stored in the given layout.
+    template< template< class > class ActivationFunctionType,
+              typename Grid,
+              std::size_t channels = 1,
+              std::size_t inputChannels = 1,
+              Layout layout = Layout::NHWC,
+              typename Var = float >
+    using SharedConvolutionLayer =
+     detail::SharedConvolutionLayer< ActivationFunctionType< Var >, Grid, channels, inputChannels, layout >;
+
+} // namespace nn
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "NeuralNetwork/NeuralLayer/Container.h"
+#include "NeuralNetwork/Math/Sparse.h"
+
+#include <System/Time.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace nn {
+    namespace detail {
+        /// @brief layer storage which keeps only the non zero weights of a
+        /// pruned layer, in the compressed sparse row format. A new layer is
+        /// fully connected, prune removes the small weights.
+        template< typename Neuron, std::size_t sz >
+        struct Sparse {
+            static constexpr auto size() {
+                return sz;
+            }
+        };
+
+        /// @brief neuron of a sparse layer. The weights belong to the layer,
+        /// the neuron gives access to its bias, output and activation
+        /// function.
+        template< typename NeuronType >
+        struct SparseNeuron {
+            using OutputFunction = typename NeuronType::OutputFunction;
+            using Var = typename NeuronType::Var;
+
+            static constexpr auto size() {
+                return NeuronType::size();
+            }
+
+            void bind(Var* bias, Var* output) {
+                m_bias = bias;
+                m_output = output;
+            }
+
+            const Var& getBias() const {
+                return *m_bias;
+            }
+
+            void setBias(Var weight) {
+                *m_bias = weight;
+            }
+
+            const Var& getOutput() const {
+                return *m_output;
+            }
+
+            void setOutput(const Var& output) {
+                *m_output = output;
+            }
+
+            template< typename Iterator >
+            const Var& calculateOutput(const Var& dotProduct, Iterator begin, Iterator end) {
+                *m_output = m_activationFunction.calculate(dotProduct, begin, end);
+                return *m_output;
+            }
+
+            /// @brief the same output as calculateOutput, but not stored, with
+            /// the activation function of this neuron.
+            template< typename Iterator >
+            Var calculateOutput(const Var& dotProduct, Iterator begin, Iterator end) const {
+                return m_activationFunction.calculate(dotProduct, begin, end);
+            }
+
+          private:
+            OutputFunction m_activationFunction;
+            Var* m_bias = nullptr;
+            Var* m_output = nullptr;
+        };
+
+        template< typename T, std::size_t sz >
+        struct Layer< detail::Sparse< T, sz > > {
+          public:
+            using Neuron = T;
+            using Var = typename Neuron::Var;
+            using Index = std::uint32_t;
+            using OutputFunction = typename Neuron::OutputFunction;
+            using ActivationFunctions = std::tuple< OutputFunction >;
+            using Container = std::array< SparseNeuron< Neuron >, sz >;
+
+            static constexpr auto inputs() {
+                return Neuron::size();
+            }
+
+            static constexpr auto size() {
+                return sz;
+            }
+
+            using Biases = std::array< Var, sz >;
+            using RowOffsets = std::array< Index, sz + 1 >;
+
+            template< template< class > typename L, template< class > class NewType >
+            using wrap_neuron = L< Sparse< NewType< Neuron >, sz > >;
+
+            template< template< class > typename L, std::size_t inputs >
+            using adjust_inputs = L< Sparse< typename Neuron::template resize< inputs >, sz > >;
+
+            template< template< class > typename L, typename V >
+            using use_var = L< Sparse< typename Neuron::template use< V >, sz > >;
+
+            template< typename NewNeuron >
+            using with_neuron =
+             detail::NeuralLayer< Sparse< typename NewNeuron::template resize< Neuron::size() >, sz > >;
+
+            Layer()
+             : m_columns(sz * inputs())
+             , m_values(sz * inputs()) {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    m_rowOffsets[i] = static_cast< Index >(i * inputs());
+                    for(std::size_t j = 0; j < inputs(); ++j) {
+                        m_columns[i * inputs() + j] = static_cast< Index >(j);
+                    }
+                }
+                m_rowOffsets[sz] = static_cast< Index >(sz * inputs());
+                for(auto& weight : m_values) {
+                    weight = utils::createRandom< Var >(1) / Var{100.f};
+                }
+                for(auto& bias : m_biases) {
+                    bias = utils::createRandom< Var >(1);
+                }
+                bind();
+            }
+
+            Layer(const Layer& other)
+             : m_rowOffsets(other.m_rowOffsets)
+             , m_columns(other.m_columns)
+             , m_values(other.m_values)
+             , m_biases(other.m_biases)
+             , m_outputs(other.m_outputs) {
+                bind();
+            }
+
+            Layer& operator=(const Layer& other) {
+                m_rowOffsets = other.m_rowOffsets;
+                m_columns = other.m_columns;
+                m_values = other.m_values;
+                m_biases = other.m_biases;
+                m_outputs = other.m_outputs;
+                return *this;
+            }
+
+            /**
+             * Keeps the weights whose magnitude is above the threshold.
+             * @param weights row-major (size() x inputs()) matrix, the layout used by bp::BPContext.
+             * @param biases one bias per neuron.
+             */
+            void prune(const Var* weights, const Var* biases, Var threshold) {
+                m_columns.clear();
+                m_values.clear();
+                for(std::size_t i = 0; i < sz; ++i) {
+                    m_rowOffsets[i] = static_cast< Index >(m_values.size());
+                    for(std::size_t j = 0; j < inputs(); ++j) {
+                        const Var weight = weights[i * inputs() + j];
+                        if(std::abs(weight) > threshold) {
+                            m_columns.push_back(static_cast< Index >(j));
+                            m_values.push_back(weight);
+                        }
+                    }
+                }
+                m_rowOffsets[sz] = static_cast< Index >(m_values.size());
+                m_columns.shrink_to_fit();
+                m_values.shrink_to_fit();
+                std::copy_n(biases, sz, m_biases.begin());
+            }
+
+            /// @brief sets the weights of the row-major (size() x inputs())
+            /// matrix which are not part of the layer to zero.
+            void mask(Var* weights) const {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    Var* row = weights + i * inputs();
+                    std::size_t column = 0;
+                    for(auto k = m_rowOffsets[i]; k < m_rowOffsets[i + 1]; ++k) {
+                        std::fill(row + column, row + m_columns[k], Var{});
+                        column = m_columns[k] + 1;
+                    }
+                    std::fill(row + column, row + inputs(), Var{});
+                }
+            }
+
+            /// @brief the number of the stored weights.
+            std::size_t nonZeros() const {
+                return m_values.size();
+            }
+
+            const RowOffsets& rowOffsets() const {
+                return m_rowOffsets;
+            }
+
+            const std::vector< Index >& columns() const {
+                return m_columns;
+            }
+
+            const std::vector< Var >& values() const {
+                return m_values;
+            }
+
+            Biases& biases() {
+                return m_biases;
+            }
+
+            const Biases& biases() const {
+                return m_biases;
+            }
+
+            const auto& operator[](unsigned int id) const {
+                return m_neurons[id];
+            }
+
+            auto& operator[](unsigned int id) {
+                return m_neurons[id];
+            }
+
+            auto cbegin() const {
+                return std::cbegin(m_neurons);
+            }
+
+            auto cend() const {
+                return std::cend(m_neurons);
+            }
+
+            auto begin() {
+                return std::begin(m_neurons);
+            }
+
+            auto end() {
+                return std::end(m_neurons);
+            }
+
+            /// @brief calculates the dot products of all neurons against the
+            /// given inputs, visiting the stored weights only.
+            void calcDotProducts(const Var* values, std::size_t count, Var* out) const {
+                std::array< Var, inputs() > padded;
+                std::copy(m_biases.begin(), m_biases.end(), out);
+                math::spmv(sz,
+                           m_rowOffsets.data(),
+                           m_columns.data(),
+                           m_values.data(),
+                           pad(values, count, padded),
+                           out);
+            }
+
+            /// @brief same as above for the dense weights and biases of the
+            /// back propagation context. Only the weights which are part of
+            /// the layer are read.
+            void calcDotProducts(const Var* weights,
+                                 const Var* biases,
+                                 const Var* values,
+                                 std::size_t count,
+                                 Var* out) const {
+                std::array< Var, inputs() > padded;
+                std::copy_n(biases, sz, out);
+                math::maskedGemv(sz,
+                                 m_rowOffsets.data(),
+                                 m_columns.data(),
+                                 weights,
+                                 inputs(),
+                                 pad(values, count, padded),
+                                 out);
+            }
+
+            /// @brief stores the outputs calculated for the whole layer.
+            void setOutputs(const Var* outputs) {
+                std::copy_n(outputs, sz, m_outputs.begin());
+            }
+
+          private:
+            /// @brief the missing inputs are zero, a layer connected to a
+            /// smaller one ignores the weights of the missing inputs.
+            static const Var* pad(const Var* values, std::size_t count, std::array< Var, inputs() >& buffer) {
+                if(count >= inputs()) {
+                    return values;
+                }
+                std::fill(std::copy_n(values, count, buffer.begin()), buffer.end(), Var{});
+                return buffer.data();
+            }
+
+            void bind() {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    m_neurons[i].bind(m_biases.data() + i, m_outputs.data() + i);
+                }
+            }
+
+            RowOffsets m_rowOffsets{};
+            std::vector< Index > m_columns;
+            std::vector< Var > m_values;
+            Biases m_biases;
+            Biases m_outputs{};
+
+          protected:
+            Container m_neurons;
+        };
+
+    } // namespace detail
+} // namespace nn
@@ -7,6 +7,7 @@
 #include <MPL/Utils.h>
 #include <MPL/TypeTraits.h>
 
+#include <array>
 #include <tuple>
 
 namespace nn {
@@ -34,7 +35,7 @@ namespace nn {
             using with_neuron =
              Layer< Tuple< Var, inputsNumber, typename T::template replace< Neuron >... > >;
 
-            using Container = std::tuple< T... >;
+            using Container = std::tuple< polymorphic_neuron_t< T >... >;
 
             static constexpr auto inputs() {
                 return inputsNumber;
@@ -47,9 +48,16 @@ namespace nn {
             static constexpr unsigned int CONST_INPUTS_NUMBER = inputsNumber;
 
             Layer() : m_neurons{} {
-                utils::for_< size() >([this](auto i) {
-                    m_neuron_interfaces[i.value] = &(std::get< i.value >(m_neurons));
-                });
+                bind();
+            }
+
+            Layer(const Layer& other) : m_neurons{other.m_neurons} {
+                bind();
+            }
+
+            Layer& operator=(const Layer& other) {
+                m_neurons = other.m_neurons;
+                return *this;
             }
 
             auto& operator[](std::size_t idx) {
@@ -76,10 +84,28 @@ namespace nn {
                 return std::end(m_neuron_interfaces);
             }
 
+            void calcDotProducts(const Var* values, std::size_t count, Var* out) const {
+                utils::for_< size() >([&](auto i) {
+                    out[i.value] = std::get< i.value >(m_neurons).calcDotProduct(values, count);
+                });
+            }
+
+            void calcDotProducts(Var* out) const {
+                utils::for_< size() >([&](auto i) {
+                    out[i.value] = std::get< i.value >(m_neurons).calcDotProduct();
+                });
+            }
+
           protected:
-            std::tuple< T... > m_neurons;
+            Container m_neurons;
 
           private:
+            void bind() {
+                utils::for_< size() >([this](auto i) {
+                    m_neuron_interfaces[i.value] = &(std::get< i.value >(m_neurons));
+                });
+            }
+
             std::array< INeuron< Var >*, size() > m_neuron_interfaces;
         };
     } // namespace detail
@@ -4,10 +4,9 @@
 
 #include <MPL/Algorithm.h>
 
-#include <vector>
+#include <array>
 #include <tuple>
 
-
 namespace nn {
     namespace detail {
         template< typename Container, std::size_t sz >
@@ -20,7 +19,7 @@ namespace nn {
         template< typename T, std::size_t sz >
         struct Layer< detail::Vector< T, sz > > {
           public:
-            using Container = std::vector< T >;
+            using Container = std::array< T, sz >;
             using Neuron = T;
             using Var = typename Neuron::Var;
             using OutputFunction = typename Neuron::OutputFunction;
@@ -72,7 +71,43 @@ namespace nn {
                 return std::end(m_neurons);
             }
 
-            Container m_neurons{sz};
+            void calcDotProducts(const Var* values, std::size_t count, Var* out) const {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    out[i] = m_neurons[i].calcDotProduct(values, count);
+                }
+            }
+
+            /// @brief dot products of a batch of samples, stride values
+            /// apart, into a row-major (sample x neuron) buffer. One neuron
+            /// at a time, its weights are reused across all samples.
+            void calcBatchDotProducts(const Var* values,
+                                      std::size_t stride,
+                                      std::size_t count,
+                                      Var* out,
+                                      std::size_t batchSize) const {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        out[sample * sz + i] = m_neurons[i].calcDotProduct(values + sample * stride, count);
+                    }
+                }
+            }
+
+            void calcDotProducts(Var* out) const {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    out[i] = m_neurons[i].calcDotProduct();
+                }
+            }
+
+            /// @brief stores the outputs calculated for the whole layer.
+            void setOutputs(const Var* outputs)
+                requires requires(T& neuron, const Var& output) { neuron.setOutput(output); }
+            {
+                for(std::size_t i = 0; i < sz; ++i) {
+                    m_neurons[i].setOutput(outputs[i]);
+                }
+            }
+
+            Container m_neurons{};
         };
 
     } // namespace detail
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
+#include "NeuralNetwork/Math/Gemm.h"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace nn::detail {
+
+    /**
+     * Winograd F(2x2, 3x3) convolution for 3x3 kernels with stride 1. Every
+     * 2x2 block of outputs is calculated from the 4x4 block of inputs it
+     * depends on with 16 instead of 36 multiplications per channel pair:
+     * Y = A^T [(G g G^T) . (B^T d B)] A. The element-wise products of all
+     * channels are summed by 16 matrix products, one per point of the
+     * transformed tile:
+     * M[point] (channels x tiles) = U[point] (channels x inputChannels) *
+     * V[point] (inputChannels x tiles).
+     * The windows, the zero padding at the right and bottom border and the
+     * layouts of the inputs, outputs and kernels are the ones of
+     * SharedConvolutionLayer.
+     */
+    template< typename Var, typename Grid, std::size_t channels, std::size_t inputChannels, Layout layout >
+    class WinogradConvolution {
+        static constexpr std::size_t width = Grid::width;
+        static constexpr std::size_t height = Grid::height;
+        static constexpr std::size_t tilesPerRow = (width + 1) / 2;
+        static constexpr std::size_t tilesPerCol = (height + 1) / 2;
+        static constexpr std::size_t tiles = tilesPerRow * tilesPerCol;
+        static constexpr std::size_t points = 16;
+        static constexpr std::size_t kernelSize = 9;
+
+      public:
+        /// @brief the Winograd transform needs divisions by two, so only
+        /// floating point values are supported.
+        static constexpr bool applicable =
+         std::is_same_v< typename Grid::K, Kernel< 3, 3, 1 > > && std::is_floating_point_v< Var >;
+
+        /// @brief U = G g G^T for every pair of an output and an input channel.
+        /// @param kernels row-major (channels x inputChannels * 9) matrix.
+        void transformKernels(const Var* kernels) {
+            for(std::size_t o = 0; o < channels; ++o) {
+                for(std::size_t c = 0; c < inputChannels; ++c) {
+                    std::array< Var, kernelSize > g;
+                    for(std::size_t local = 0; local < kernelSize; ++local) {
+                        g[local] = kernels[o * inputChannels * kernelSize + column(c, local)];
+                    }
+
+                    // G g, 4x3
+                    std::array< Var, 12 > gg;
+                    for(std::size_t x = 0; x < 3; ++x) {
+                        const Var g0 = g[x], g1 = g[3 + x], g2 = g[6 + x];
+                        gg[x] = g0;
+                        gg[3 + x] = (g0 + g1 + g2) / Var{2};
+                        gg[6 + x] = (g0 - g1 + g2) / Var{2};
+                        gg[9 + x] = g2;
+                    }
+                    // (G g) G^T, 4x4
+                    for(std::size_t y = 0; y < 4; ++y) {
+                        const Var g0 = gg[y * 3], g1 = gg[y * 3 + 1], g2 = gg[y * 3 + 2];
+                        const std::array< Var, 4 > row{g0, (g0 + g1 + g2) / Var{2}, (g0 - g1 + g2) / Var{2}, g2};
+                        for(std::size_t x = 0; x < 4; ++x) {
+                            m_kernels[((y * 4 + x) * channels + o) * inputChannels + c] = row[x];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * Calculates the outputs of the layer with the kernels of the last
+         * transformKernels call.
+         * @param count the number of inputs, the missing ones are zero.
+         */
+        void convolve(const Var* in, std::size_t count, const Var* biases, Var* out) {
+            transformInputs(in, count);
+            for(std::size_t point = 0; point < points; ++point) {
+                math::gemm(math::Transpose::No,
+                           math::Transpose::No,
+                           channels,
+                           tiles,
+                           inputChannels,
+                           Var{1},
+                           m_kernels.data() + point * channels * inputChannels,
+                           inputChannels,
+                           m_tiles.data() + point * inputChannels * tiles,
+                           tiles,
+                           Var{0},
+                           m_products.data() + point * channels * tiles,
+                           tiles);
+            }
+            transformOutputs(biases, out);
+        }
+
+      private:
+        static constexpr std::size_t column(std::size_t channel, std::size_t local) {
+            return layout == Layout::NHWC ? local * inputChannels + channel : channel * kernelSize + local;
+        }
+
+        static constexpr std::size_t input(std::size_t channel, std::size_t y, std::size_t x) {
+            return layout == Layout::NHWC ? (y * width + x) * inputChannels + channel
+                                          : channel * Grid::size + y * width + x;
+        }
+
+        static constexpr std::size_t output(std::size_t channel, std::size_t y, std::size_t x) {
+            return layout == Layout::NHWC ? (y * width + x) * channels + channel
+                                          : channel * Grid::framesNumber + y * width + x;
+        }
+
+        /// @brief V = B^T d B for every input channel and tile.
+        void transformInputs(const Var* in, std::size_t count) {
+            for(std::size_t c = 0; c < inputChannels; ++c) {
+                for(std::size_t ty = 0; ty < tilesPerCol; ++ty) {
+                    for(std::size_t tx = 0; tx < tilesPerRow; ++tx) {
+                        std::array< Var, points > d;
+                        for(std::size_t y = 0; y < 4; ++y) {
+                            for(std::size_t x = 0; x < 4; ++x) {
+                                const auto gy = ty * 2 + y, gx = tx * 2 + x;
+                                const auto i = input(c, gy, gx);
+                                d[y * 4 + x] = gy < height && gx < width && i < count ? in[i] : Var{};
+                            }
+                        }
+
+                        // B^T d
+                        std::array< Var, points > bd;
+                        for(std::size_t x = 0; x < 4; ++x) {
+                            const Var d0 = d[x], d1 = d[4 + x], d2 = d[8 + x], d3 = d[12 + x];
+                            bd[x] = d0 - d2;
+                            bd[4 + x] = d1 + d2;
+                            bd[8 + x] = d2 - d1;
+                            bd[12 + x] = d1 - d3;
+                        }
+                        // (B^T d) B
+                        const auto tile = ty * tilesPerRow + tx;
+                        for(std::size_t y = 0; y < 4; ++y) {
+                            const Var d0 = bd[y * 4], d1 = bd[y * 4 + 1], d2 = bd[y * 4 + 2], d3 = bd[y * 4 + 3];
+                            const std::array< Var, 4 > row{d0 - d2, d1 + d2, d2 - d1, d1 - d3};
+                            for(std::size_t x = 0; x < 4; ++x) {
+                                m_tiles[((y * 4 + x) * inputChannels + c) * tiles + tile] = row[x];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /// @brief Y = A^T M A, the outputs outside of the grid are dropped.
+        void transformOutputs(const Var* biases, Var* out) const {
+            for(std::size_t o = 0; o < channels; ++o) {
+                for(std::size_t ty = 0; ty < tilesPerCol; ++ty) {
+                    for(std::size_t tx = 0; tx < tilesPerRow; ++tx) {
+                        const auto tile = ty * tilesPerRow + tx;
+                        std::array< Var, points > m;
+                        for(std::size_t point = 0; point < points; ++point) {
+                            m[point] = m_products[(point * channels + o) * tiles + tile];
+                        }
+
+                        // A^T M, 2x4
+                        std::array< Var, 8 > am;
+                        for(std::size_t x = 0; x < 4; ++x) {
+                            am[x] = m[x] + m[4 + x] + m[8 + x];
+                            am[4 + x] = m[4 + x] - m[8 + x] - m[12 + x];
+                        }
+                        // (A^T M) A, 2x2
+                        for(std::size_t y = 0; y < 2; ++y) {
+                            const Var* row = am.data() + y * 4;
+                            const std::array< Var, 2 > values{row[0] + row[1] + row[2], row[1] - row[2] - row[3]};
+                            for(std::size_t x = 0; x < 2; ++x) {
+                                const auto gy = ty * 2 + y, gx = tx * 2 + x;
+                                if(gy < height && gx < width) {
+                                    out[output(o, gy, gx)] = values[x] + biases[o];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        std::array< Var, points * channels * inputChannels > m_kernels{};
+        std::array< Var, points * inputChannels * tiles > m_tiles{};
+        std::array< Var, points * channels * tiles > m_products{};
+    };
+} // namespace nn::detail
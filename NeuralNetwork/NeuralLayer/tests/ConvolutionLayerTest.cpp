@@ -1,10 +1,17 @@
 #include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
 #include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/SharedConvolutionLayer.h"
 #include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
 #include "NeuralNetwork/Neuron/Neuron.h"
 
 #include <range/v3/all.hpp>
 
+#include <array>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <vector>
+
 #define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
 #include <catch2/catch_all.hpp>
 
@@ -54,5 +61,258 @@ namespace {
         }
     }
 
+    SCENARIO("Convolution layer lowers the windows into a patch matrix", "[layer][convolution][forward]") {
+        GIVEN("A convolution layer for an image 5*5, stride = 2 and kernel 3*3") {
+            using SlidingWindow = nn::SlidingWindow< 5, 5, nn::Kernel< 3, 3, 2 > >;
+            using ConvolutionLayer =
+             nn::ConvolutionLayer< nn::NeuralLayer, nn::Neuron, nn::SigmoidFunction, SlidingWindow >;
+            using Context = std::tuple< std::array< float, 25 >, std::array< float, 9 > >;
+
+            auto layer = ConvolutionLayer{};
+            Context ctx;
+            auto& image = std::get< 0 >(ctx);
+            for(auto i : ranges::views::ints(0, 25)) {
+                image[i] = static_cast< float >(i + 1);
+            }
+
+            WHEN("the outputs are calculated from the predecessor") {
+                layer.calculateOutputs< Context, 1, 0 >(ctx);
+
+                THEN("every row of the patch matrix is the window of a neuron") {
+                    auto reference = ConvolutionLayer{};
+                    for(auto i : ranges::views::ints(0, 25)) {
+                        reference.setInput(i, image[i]);
+                    }
+                    REQUIRE(layer.patches() == reference.patches());
+                }
+
+                THEN("the outputs are the same as the ones calculated from the inputs of the neurons") {
+                    auto reference = layer;
+                    for(auto i : ranges::views::ints(0, 25)) {
+                        reference.setInput(i, image[i]);
+                    }
+                    std::tuple< std::array< float, 9 > > referenceCtx;
+                    reference.calculateOutputs< decltype(referenceCtx), 0 >(referenceCtx);
+                    for(auto i : ranges::views::ints(0, 9)) {
+                        REQUIRE_THAT(std::get< 1 >(ctx)[i],
+                                     Catch::Matchers::WithinRel(std::get< 0 >(referenceCtx)[i], 1e-6f));
+                    }
+                }
+            }
+
+            WHEN("the outputs of a batch are calculated") {
+                constexpr std::size_t batchSize = 3;
+                std::tuple< std::vector< float >, std::vector< float > > batchCtx;
+                auto& images = std::get< 0 >(batchCtx);
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    for(auto i : ranges::views::ints(0, 25)) {
+                        images.push_back(std::sin(static_cast< float >(sample * 25 + i)));
+                    }
+                }
+                std::get< 1 >(batchCtx).resize(batchSize * 9);
+                layer.calculateBatchOutputs< decltype(batchCtx), 1, 0 >(batchCtx, batchSize);
+
+                THEN("the outputs are the same as the ones of every sample") {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        std::copy_n(images.begin() + sample * 25, 25, image.begin());
+                        layer.calculateOutputs< Context, 1, 0 >(ctx);
+                        for(auto i : ranges::views::ints(0, 9)) {
+                            REQUIRE_THAT(std::get< 1 >(batchCtx)[sample * 9 + i],
+                                         Catch::Matchers::WithinRel(std::get< 1 >(ctx)[i], 1e-5f));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief the gather and the scatter tables of the grid agree with
+    /// contains and localize.
+    template< typename Grid >
+    void requireWindowTables() {
+        const auto& gather = Grid::gather();
+        for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+            for(std::size_t local = 0; local < Grid::K::size; ++local) {
+                const auto input = gather[w * Grid::K::size + local];
+                if(input != Grid::outside) {
+                    REQUIRE(Grid::contains(input, w));
+                    REQUIRE(Grid::localize(input, w) == local);
+                }
+            }
+        }
 
+        const auto& offsets = Grid::scatterOffsets();
+        const auto& scatter = Grid::scatter();
+        REQUIRE(offsets[Grid::size] == scatter.size());
+        for(std::size_t input = 0; input < Grid::size; ++input) {
+            std::size_t windows = 0;
+            for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                windows += Grid::contains(input, w) ? 1 : 0;
+            }
+            REQUIRE(offsets[input + 1] - offsets[input] == windows);
+            for(auto c = offsets[input]; c < offsets[input + 1]; ++c) {
+                REQUIRE(Grid::contains(input, scatter[c].window));
+                REQUIRE(Grid::localize(input, scatter[c].window) == scatter[c].local);
+            }
+        }
+    }
+
+    SCENARIO("Sliding window index tables", "[layer][convolution][grid]") {
+        GIVEN("a 7*6 grid with a 3*2 kernel and stride 2") {
+            using Grid = nn::SlidingWindow< 7, 6, nn::Kernel< 3, 2, 2 > >;
+
+            THEN("the tables list the inputs of every window and the windows of every input") {
+                requireWindowTables< Grid >();
+            }
+
+            THEN("the tables are built at compile time") {
+                STATIC_REQUIRE(Grid::precomputed);
+                STATIC_REQUIRE(nn::detail::precomputedTables< Grid::Tables >.gather[Grid::K::size + 1] == 3);
+                STATIC_REQUIRE(nn::detail::precomputedTables< Grid::Tables >.scatterOffsets[Grid::size] ==
+                               Grid::Tables::connections());
+            }
+
+            THEN("col2im is the transposed lowering") {
+                std::vector< float > values(Grid::framesNumber * Grid::K::size);
+                std::vector< float > factors(Grid::framesNumber);
+                for(std::size_t i = 0; i < values.size(); ++i) {
+                    values[i] = std::sin(static_cast< float >(i));
+                }
+                for(std::size_t i = 0; i < factors.size(); ++i) {
+                    factors[i] = std::cos(static_cast< float >(i));
+                }
+
+                std::vector< float > out(Grid::size + 2, 1.f);
+                Grid::col2im(values.data(), factors.data(), out.data(), out.size());
+                for(std::size_t input = 0; input < Grid::size; ++input) {
+                    float expected = 0.f;
+                    for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                        if(Grid::contains(input, w)) {
+                            expected += values[w * Grid::K::size + Grid::localize(input, w)] * factors[w];
+                        }
+                    }
+                    REQUIRE_THAT(out[input], Catch::Matchers::WithinAbs(expected, 1e-5f));
+                }
+                REQUIRE(out[Grid::size] == 0.f);
+                REQUIRE(out[Grid::size + 1] == 0.f);
+            }
+        }
+
+        GIVEN("a 64*64 grid with a 7*7 kernel and stride 1") {
+            using Grid = nn::SlidingWindow< 64, 64, nn::Kernel< 7, 7, 1 > >;
+
+            THEN("the tables are too large for the constant evaluation and are built at the first use") {
+                STATIC_REQUIRE(!Grid::precomputed);
+                requireWindowTables< Grid >();
+            }
+
+            THEN("a convolution layer over the grid gets the inputs of every window") {
+                using ConvolutionLayer =
+                 nn::ConvolutionLayer< nn::NeuralLayer, nn::Neuron, nn::SigmoidFunction, Grid >;
+                auto layer = std::make_unique< ConvolutionLayer >();
+                for(std::size_t i = 0; i < Grid::size; ++i) {
+                    layer->setInput(i, static_cast< float >(i + 1));
+                }
+                for(const std::size_t w : {std::size_t{0}, std::size_t{65}, Grid::framesNumber - 1}) {
+                    for(std::size_t local = 0; local < Grid::K::size; ++local) {
+                        const auto input = Grid::gather()[w * Grid::K::size + local];
+                        const float expected = input == Grid::outside ? 0.f : static_cast< float >(input + 1);
+                        REQUIRE((*layer)[w][local].value == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    SCENARIO("Winograd convolution gives the outputs of the direct convolution", "[layer][convolution][winograd]") {
+        GIVEN("a 7*6 grid with a 3*3 kernel and stride 1") {
+            using SlidingWindow = nn::SlidingWindow< 7, 6, nn::Kernel< 3, 3, 1 > >;
+            using ConvolutionLayer =
+             nn::ConvolutionLayer< nn::NeuralLayer, nn::Neuron, nn::SigmoidFunction, SlidingWindow >;
+            using SharedLayer = nn::SharedConvolutionLayer< nn::SigmoidFunction, SlidingWindow >;
+            using Context = std::tuple< std::array< float, 42 >, std::array< float, 42 > >;
+
+            const std::array< float, 9 > kernel{0.5f, -1.f, 0.25f, 2.f, 0.75f, -0.5f, 1.5f, -0.25f, 1.f};
+            constexpr float bias = 0.125f;
+
+            auto direct = ConvolutionLayer{};
+            for(std::size_t w = 0; w < SlidingWindow::framesNumber; ++w) {
+                for(std::size_t j = 0; j < kernel.size(); ++j) {
+                    direct[w][j].weight = kernel[j];
+                }
+                direct[w].setBias(bias);
+            }
+            auto winograd = SharedLayer{};
+            std::copy(kernel.begin(), kernel.end(), winograd.kernels().begin());
+            winograd.biases()[0] = bias;
+
+            Context ctx;
+            for(std::size_t i = 0; i < 42; ++i) {
+                std::get< 0 >(ctx)[i] = std::sin(static_cast< float >(i));
+            }
+
+            WHEN("both layers calculate the outputs of the same image") {
+                direct.calculateOutputs< Context, 1, 0 >(ctx);
+                const auto expected = std::get< 1 >(ctx);
+                winograd.calculateOutputs< Context, 1, 0 >(ctx);
+
+                THEN("the outputs are the same, also at the right and bottom border") {
+                    for(std::size_t i = 0; i < expected.size(); ++i) {
+                        REQUIRE_THAT(std::get< 1 >(ctx)[i], Catch::Matchers::WithinAbs(expected[i], 1e-6f));
+                    }
+                }
+            }
+        }
+    }
+
+    SCENARIO("FFT convolution gives the outputs of the direct convolution", "[layer][convolution][fft]") {
+        GIVEN("a 64*64 grid with two channels, two kernels of 7*7 and stride 1") {
+            using SlidingWindow = nn::SlidingWindow< 64, 64, nn::Kernel< 7, 7, 1 > >;
+            constexpr std::size_t channels = 2;
+            constexpr std::size_t inputChannels = 2;
+            using SharedLayer = nn::SharedConvolutionLayer< nn::SigmoidFunction, SlidingWindow, channels, inputChannels >;
+            using Context = std::tuple< std::array< float, SlidingWindow::size * inputChannels >,
+                                        std::array< float, SlidingWindow::framesNumber * channels > >;
+            static_assert(
+             nn::detail::FftConvolution< float, SlidingWindow, channels, inputChannels, nn::Layout::NHWC >::applicable);
+
+            auto fft = std::make_unique< SharedLayer >();
+            for(std::size_t i = 0; i < fft->kernels().size(); ++i) {
+                fft->kernels()[i] = 0.25f * std::cos(static_cast< float >(i));
+            }
+            fft->biases() = {0.125f, -0.25f};
+
+            Context ctx;
+            auto& in = std::get< 0 >(ctx);
+            for(std::size_t i = 0; i < in.size(); ++i) {
+                in[i] = std::sin(static_cast< float >(i));
+            }
+
+            WHEN("the layer calculates the outputs of an image") {
+                fft->calculateOutputs< Context, 1, 0 >(ctx);
+
+                THEN("the outputs are the ones of the windows calculated input by input, also at the borders") {
+                    const auto& gather = SlidingWindow::gather();
+                    for(std::size_t w = 0; w < SlidingWindow::framesNumber; ++w) {
+                        for(std::size_t c = 0; c < channels; ++c) {
+                            float sum = fft->biases()[c];
+                            for(std::size_t j = 0; j < SlidingWindow::K::size; ++j) {
+                                const auto input = gather[w * SlidingWindow::K::size + j];
+                                if(input == SlidingWindow::outside) {
+                                    continue;
+                                }
+                                for(std::size_t ic = 0; ic < inputChannels; ++ic) {
+                                    sum += in[input * inputChannels + ic] *
+                                           fft->kernels()[c * SharedLayer::inputs() + j * inputChannels + ic];
+                                }
+                            }
+                            const float expected = 1.f / (1.f + std::exp(-sum));
+                            REQUIRE_THAT(std::get< 1 >(ctx)[w * channels + c],
+                                         Catch::Matchers::WithinAbs(expected, 1e-5f));
+                        }
+                    }
+                }
+            }
+        }
+    }
 } // namespace
@@ -0,0 +1,125 @@
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+#ifdef NN_MATH_HAS_FLOAT16
+    using HalfTypes = std::tuple< nn::math::float16, nn::math::bfloat16 >;
+#else
+    using HalfTypes = std::tuple< nn::math::bfloat16 >;
+#endif
+
+    SCENARIO("MatrixNeuralLayer compared to regular NeuralLayer",
+             "[layer][matrix][forward]") {
+        GIVEN(
+         "A MatrixNeuralLayer with 3 neurons and 4 inputs as well as a "
+         "regular layer with the same topology") {
+            nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 3, 4 > regularLayer;
+            nn::MatrixNeuralLayer< nn::Neuron, nn::SigmoidFunction, 3, 4 > matrixLayer;
+
+            for(auto i : {0, 1, 2}) {
+                matrixLayer[i].setBias(regularLayer[i].getBias());
+                for(auto j : {0, 1, 2, 3}) {
+                    matrixLayer[i].setWeight(j, regularLayer[i].getWeight(j));
+                }
+            }
+
+            WHEN("The weights are set through the neurons") {
+                THEN("They are stored in one row-major matrix") {
+                    const auto& weights = matrixLayer.weights();
+                    for(auto i : {0, 1, 2}) {
+                        REQUIRE(matrixLayer.biases()[i] == regularLayer[i].getBias());
+                        for(auto j : {0, 1, 2, 3}) {
+                            REQUIRE(weights[i * 4 + j] == regularLayer[i].getWeight(j));
+                        }
+                    }
+                }
+            }
+
+            WHEN("Both layers calculate the outputs of the same predecessor") {
+                using Context = std::tuple< std::array< float, 4 >, std::array< float, 3 > >;
+                Context regCtx{{0.1f, 0.2f, 0.3f, 0.4f}, {}};
+                Context matrixCtx = regCtx;
+                regularLayer.calculateOutputs< Context, 1, 0 >(regCtx);
+                matrixLayer.calculateOutputs< Context, 1, 0 >(matrixCtx);
+                THEN("The outputs of both layers are identical") {
+                    for(auto i : {0, 1, 2}) {
+                        REQUIRE_THAT(std::get< 1 >(regCtx)[i],
+                                     Catch::Matchers::WithinRel(std::get< 1 >(matrixCtx)[i]));
+                        REQUIRE_THAT(regularLayer[i].getOutput(),
+                                     Catch::Matchers::WithinRel(matrixLayer[i].getOutput()));
+                    }
+                }
+            }
+
+            WHEN("The layer is copied") {
+                auto copy = matrixLayer;
+                copy[0].setBias(10.f);
+                copy[0][1] = nn::Input< float >{2.f, 3.f};
+                THEN("The copy owns its own storage") {
+                    REQUIRE(copy.biases()[0] == 10.f);
+                    REQUIRE(copy.weights()[1] == 2.f);
+                    REQUIRE(copy[0][1].value == 3.f);
+                    REQUIRE(matrixLayer[0].getBias() == regularLayer[0].getBias());
+                    REQUIRE(matrixLayer[0][1].weight == regularLayer[0].getWeight(1));
+                }
+            }
+        }
+    }
+
+    TEMPLATE_LIST_TEST_CASE("MatrixNeuralLayer with the weights in half precision", "[layer][matrix][half]", HalfTypes) {
+        GIVEN("A half precision layer and a float layer with the same weights") {
+            nn::HalfMatrixNeuralLayer< nn::Neuron, nn::SigmoidFunction, 3, 4, TestType > halfLayer;
+            nn::MatrixNeuralLayer< nn::Neuron, nn::SigmoidFunction, 3, 4 > floatLayer;
+
+            // multiples of 1/8 are exact in both half precision types
+            for(auto i : {0, 1, 2}) {
+                floatLayer[i].setBias(halfLayer[i].getBias());
+                for(auto j : {0, 1, 2, 3}) {
+                    const auto weight = static_cast< float >(i * 4 + j - 6) / 8.f;
+                    halfLayer[i].setWeight(j, weight);
+                    floatLayer[i].setWeight(j, weight);
+                }
+            }
+
+            THEN("The weights take half of the memory") {
+                STATIC_REQUIRE(sizeof(halfLayer.weights()) * 2 == sizeof(floatLayer.weights()));
+                REQUIRE(halfLayer[2].getWeight(3) == 0.625f);
+                REQUIRE(static_cast< nn::Input< float > >(halfLayer[0][1]).weight == -0.625f);
+            }
+
+            WHEN("Both layers calculate the outputs of the same predecessor") {
+                using Context = std::tuple< std::array< float, 4 >, std::array< float, 3 > >;
+                Context floatCtx{{0.1f, 0.2f, 0.3f, 0.4f}, {}};
+                Context halfCtx = floatCtx;
+                floatLayer.calculateOutputs< Context, 1, 0 >(floatCtx);
+                halfLayer.template calculateOutputs< Context, 1, 0 >(halfCtx);
+                THEN("The outputs are calculated in float") {
+                    for(auto i : {0, 1, 2}) {
+                        REQUIRE(std::get< 1 >(halfCtx)[i] == Catch::Approx(std::get< 1 >(floatCtx)[i]));
+                    }
+                }
+            }
+
+            WHEN("Both layers calculate the outputs of a batch") {
+                using BatchContext = std::tuple< std::vector< float >, std::vector< float > >;
+                BatchContext floatCtx{{0.1f, 0.2f, 0.3f, 0.4f, -1.f, 0.5f, 2.f, 0.f}, std::vector< float >(6)};
+                BatchContext halfCtx = floatCtx;
+                floatLayer.calculateBatchOutputs< BatchContext, 1, 0 >(floatCtx, 2);
+                halfLayer.template calculateBatchOutputs< BatchContext, 1, 0 >(halfCtx, 2);
+                THEN("The outputs are the same") {
+                    for(std::size_t i = 0; i < 6; ++i) {
+                        REQUIRE(std::get< 1 >(halfCtx)[i] == Catch::Approx(std::get< 1 >(floatCtx)[i]));
+                    }
+                }
+            }
+        }
+    }
+} // namespace
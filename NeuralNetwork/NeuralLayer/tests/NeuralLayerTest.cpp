@@ -2,6 +2,10 @@
 #include "NeuralNetwork/Neuron/Neuron.h"
 #include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
 
+#include <cmath>
+#include <tuple>
+#include <vector>
+
 #define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
 #include <catch2/catch_all.hpp>
 
@@ -32,6 +36,28 @@ namespace {
                             Catch::Approx(1.f / (1.f + std::exp(-3.f))));
                 }
             }
+
+            WHEN("the outputs of a batch are calculated") {
+                using Context = std::tuple< std::vector< float >, std::vector< float > >;
+                Context ctx{{1.f, 1.f, 2.f, -1.f}, std::vector< float >(4)};
+                layer.calculateBatchOutputs< Context, 1, 0 >(ctx, 2);
+                THEN("every sample is calculated with the weights of all neurons") {
+                    const auto& outputs = std::get< 1 >(ctx);
+                    REQUIRE(outputs[0] == Catch::Approx(1.f / (1.f + std::exp(-3.f))));
+                    REQUIRE(outputs[1] == Catch::Approx(1.f / (1.f + std::exp(-3.f))));
+                    REQUIRE(outputs[2] == Catch::Approx(1.f / (1.f + std::exp(-2.f))));
+                    REQUIRE(outputs[3] == Catch::Approx(1.f / (1.f + std::exp(-2.f))));
+                }
+            }
+
+            WHEN("the outputs of an empty batch are calculated") {
+                using Context = std::tuple< std::vector< float >, std::vector< float > >;
+                Context ctx;
+                layer.calculateBatchOutputs< Context, 1, 0 >(ctx, 0);
+                THEN("nothing is calculated") {
+                    REQUIRE(std::get< 1 >(ctx).empty());
+                }
+            }
         }
     }
 } // namespace
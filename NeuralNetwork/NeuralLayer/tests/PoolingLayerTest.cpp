@@ -1,31 +1,39 @@
 #include "NeuralNetwork/NeuralLayer/PoolingLayer.h"
-#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
-#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
 #include "NeuralNetwork/Neuron/PoolingNeuron.h"
 
 #include <range/v3/all.hpp>
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
 #define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
 #include <catch2/catch_all.hpp>
 
 namespace {
-    template< typename T >
-    bool equal(T lhs, T rhs) {
-        return std::abs(lhs - rhs) < std::numeric_limits< T >::epsilon();
+    /// @brief the values of a window as the convolution lowers them.
+    template< typename Grid >
+    std::vector< float > window(const std::vector< float >& in, std::size_t count, std::size_t w) {
+        std::vector< float > values;
+        for(std::size_t j = 0; j < Grid::K::size; ++j) {
+            const auto input = Grid::gather()[w * Grid::K::size + j];
+            values.push_back(input < count ? in[input] : 0.f);
+        }
+        return values;
     }
 
-    template< typename Neuron >
-    bool hasValidInputs(const Neuron& neuron, const std::vector< float >& expected) {
-        for(std::size_t i = 0; i < expected.size(); i++) {
-            if(!equal(neuron[i].value, expected[i])) {
-                return false;
-            }
+    /// @brief an algorithm without a dedicated kernel.
+    template< typename T >
+    struct Min {
+        template< typename I >
+        T operator()(I begin, I end) const {
+            return *std::min_element(begin, end);
         }
+    };
 
-        return true;
-    }
-
-    SCENARIO("Pooling grid set inputs", "[layer][pooling][grid][forward]") {
+    SCENARIO("Pooling grid", "[layer][pooling][grid][forward]") {
         GIVEN(
          "A pooling layer for an image 6*6, kernel 3*3 and Max as pooling "
          "algorithm") {
@@ -35,46 +43,131 @@ namespace {
 
             using Grid =
              nn::SlidingWindow< width, height, nn::Kernel< 3, 3, stride > >;
-            using PoolingLayer = nn::PoolingLayer< nn::NeuralLayer, nn::Max, Grid >;
+            using PoolingLayer = nn::PoolingLayer< nn::Max, Grid >;
+            using Context = std::tuple< std::array< float, 36 >, std::array< float, 4 > >;
 
             auto layer = PoolingLayer{};
             WHEN(
              "input is a grid filled with the increasing sequence of "
              "integers") {
+                Context ctx;
                 for(auto i : ranges::views::ints(0, 36)) {
-                    layer.setInput(i, static_cast< float >(i + 1));
+                    std::get< 0 >(ctx)[i] = static_cast< float >(i + 1);
                 }
+                layer.calculateOutputs< Context, 1, 0 >(ctx);
 
-                THEN("The layer has 4 neurons") {
+                THEN("The layer has 4 outputs") {
                     REQUIRE(4 == layer.size());
                 }
 
-                THEN("The expected inputs can be described as a following") {
-                    std::vector< std::vector< float > > inputs = {
-                     {1, 2, 3, 7, 8, 9, 13, 14, 15},
-                     {4, 5, 6, 10, 11, 12, 16, 17, 18},
-                     {19, 20, 21, 25, 26, 27, 31, 32, 33},
-                     {22, 23, 24, 28, 29, 30, 34, 35, 36}};
-
-                    for(const auto id : ranges::views::ints(0, 4)) {
-                        for(const auto input : ranges::views::ints(0, 9)) {
-                            REQUIRE_THAT(layer[id][input],
-                                         Catch::Matchers::WithinRel(inputs[id][input]));
-                        }
-                    }
+                THEN("The outputs are the max of the inputs of each window") {
+                    const auto& outputs = std::get< 1 >(ctx);
+                    REQUIRE_THAT(15.0f, Catch::Matchers::WithinRel(outputs[0]));
+                    REQUIRE_THAT(18.0f, Catch::Matchers::WithinRel(outputs[1]));
+                    REQUIRE_THAT(33.0f, Catch::Matchers::WithinRel(outputs[2]));
+                    REQUIRE_THAT(36.0f, Catch::Matchers::WithinRel(outputs[3]));
+                }
+
+                THEN("The layer records the inputs the outputs are taken from") {
+                    REQUIRE(layer.argmax() == PoolingLayer::Argmax{14, 17, 32, 35});
+                }
+            }
+        }
+    }
+
+    TEMPLATE_TEST_CASE("Pooling kernels give the algorithm applied to the lowered windows",
+                       "[layer][pooling]",
+                       (nn::SlidingWindow< 7, 5, nn::Kernel< 3, 2, 2 > >),
+                       (nn::SlidingWindow< 8, 8, nn::Kernel< 2, 2, 2 > >),
+                       (nn::SlidingWindow< 6, 5, nn::Kernel< 3, 3, 1 > >),
+                       (nn::SlidingWindow< 2, 3, nn::Kernel< 4, 4, 1 > >),
+                       (nn::SlidingWindow< 9, 7, nn::Kernel< 5, 4, 1 > >),
+                       (nn::SlidingWindow< 8, 7, nn::Kernel< 2, 2, 3 > >)) {
+        using Grid = TestType;
+        std::vector< float > in(Grid::size);
+        for(std::size_t i = 0; i < in.size(); ++i) {
+            in[i] = std::sin(static_cast< float >(i * 7 % 11)) - 0.5f;
+        }
+        // all inputs or a smaller predecessor
+        const std::size_t count = Grid::size / GENERATE(1, 2);
+        using Context = std::tuple< std::vector< float >, std::array< float, Grid::framesNumber > >;
+        Context ctx;
+        std::get< 0 >(ctx).assign(in.begin(), in.begin() + static_cast< std::ptrdiff_t >(count));
+        const auto& outputs = std::get< 1 >(ctx);
+
+        SECTION("max pooling") {
+            nn::PoolingLayer< nn::Max, Grid > layer;
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                const auto values = window< Grid >(in, count, w);
+                REQUIRE(outputs[w] == nn::Max< float >{}(values.begin(), values.end()));
+                const auto input = layer.argmax()[w];
+                if(input == Grid::outside) {
+                    REQUIRE(outputs[w] == 0.f);
+                } else {
+                    REQUIRE(input < count);
+                    REQUIRE(Grid::contains(input, w));
+                    REQUIRE(in[input] == outputs[w]);
+                }
+            }
+        }
+
+        SECTION("average pooling") {
+            nn::PoolingLayer< nn::Avg, Grid > layer;
+            STATIC_REQUIRE(!decltype(layer)::recordsArgmax);
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                const auto values = window< Grid >(in, count, w);
+                REQUIRE(outputs[w] == nn::Avg< float >{}(values.begin(), values.end()));
+            }
+        }
+
+        SECTION("sliding window max gives the outputs and the argmax of max pooling") {
+            nn::PoolingLayer< nn::Max, Grid > max;
+            nn::PoolingLayer< nn::SlidingMax, Grid > sliding;
+            max.template calculateOutputs< Context, 1, 0 >(ctx);
+            const auto expected = outputs;
+            sliding.template calculateOutputs< Context, 1, 0 >(ctx);
+            REQUIRE(outputs == expected);
+            REQUIRE(sliding.argmax() == max.argmax());
+        }
+
+        SECTION("summed area table average") {
+            nn::PoolingLayer< nn::SummedAreaAvg, Grid > layer;
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                const auto values = window< Grid >(in, count, w);
+                REQUIRE_THAT(outputs[w],
+                             Catch::Matchers::WithinAbs(nn::Avg< float >{}(values.begin(), values.end()), 1e-6));
+            }
+        }
+
+        SECTION("an algorithm without a kernel") {
+            nn::PoolingLayer< Min, Grid > layer;
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                const auto values = window< Grid >(in, count, w);
+                REQUIRE(outputs[w] == Min< float >{}(values.begin(), values.end()));
+            }
+        }
+
+        SECTION("every sample of a batch gives the same outputs as alone") {
+            constexpr std::size_t batchSize = 3;
+            std::tuple< std::vector< float >, std::vector< float > > batchCtx;
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                for(std::size_t i = 0; i < count; ++i) {
+                    std::get< 0 >(batchCtx).push_back(in[i] * static_cast< float >(sample + 1));
                 }
+            }
+            std::get< 1 >(batchCtx).resize(batchSize * Grid::framesNumber);
+            nn::PoolingLayer< nn::Max, Grid > layer;
+            layer.template calculateBatchOutputs< decltype(batchCtx), 1, 0 >(batchCtx, batchSize);
 
-                WHEN("calculateOutputs is called") {
-                    THEN(
-                     "The outputs are the max of the inputs for each neuron") {
-                        using Context = std::tuple<std::array<float, 4>>;
-                        Context ctx;
-                        layer.calculateOutputs<Context, 0>(ctx);
-                        REQUIRE_THAT(15.0f, Catch::Matchers::WithinRel(layer[0].getOutput()));
-                        REQUIRE_THAT(18.0f, Catch::Matchers::WithinRel(layer[1].getOutput()));
-                        REQUIRE_THAT(33.0f, Catch::Matchers::WithinRel(layer[2].getOutput()));
-                        REQUIRE_THAT(36.0f, Catch::Matchers::WithinRel(layer[3].getOutput()));
-                    }
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                std::copy_n(std::get< 0 >(batchCtx).begin() + sample * count, count, std::get< 0 >(ctx).begin());
+                layer.template calculateOutputs< Context, 1, 0 >(ctx);
+                for(std::size_t w = 0; w < Grid::framesNumber; ++w) {
+                    REQUIRE(std::get< 1 >(batchCtx)[sample * Grid::framesNumber + w] == outputs[w]);
                 }
             }
         }
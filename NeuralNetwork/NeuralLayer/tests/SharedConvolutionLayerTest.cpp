@@ -0,0 +1,168 @@
+#include "NeuralNetwork/NeuralLayer/SharedConvolutionLayer.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    template< typename SlidingWindow, std::size_t outputs, std::size_t inputs, nn::Layout layout >
+    struct Config {
+        using Grid = SlidingWindow;
+        static constexpr std::size_t channels = outputs;
+        static constexpr std::size_t inputChannels = inputs;
+        static constexpr bool nhwc = layout == nn::Layout::NHWC;
+        using Layer = nn::SharedConvolutionLayer< nn::TanhFunction, Grid, channels, inputChannels, layout >;
+        using Context = std::tuple< std::array< float, Grid::size * inputChannels >, std::array< float, Layer::size() > >;
+
+        static std::size_t input(std::size_t channel, std::size_t position) {
+            return nhwc ? position * inputChannels + channel : channel * Grid::size + position;
+        }
+
+        static std::size_t output(std::size_t channel, std::size_t window) {
+            return nhwc ? window * channels + channel : channel * Grid::framesNumber + window;
+        }
+
+        static std::size_t weight(std::size_t output, std::size_t channel, std::size_t local) {
+            return output * Layer::inputs()
+                   + (nhwc ? local * inputChannels + channel : channel * Grid::K::size + local);
+        }
+    };
+
+    using Grid = nn::SlidingWindow< 6, 5, nn::Kernel< 3, 2, 2 > >;
+    using Pointwise = nn::SlidingWindow< 4, 3, nn::Kernel< 1, 1, 1 > >;
+    using Winograd = nn::SlidingWindow< 7, 5, nn::Kernel< 3, 3, 1 > >;
+    using Large = nn::SlidingWindow< 12, 10, nn::Kernel< 9, 9, 1 > >;
+    static_assert(nn::detail::FftConvolution< float, Large, 3, 2, nn::Layout::NHWC >::applicable);
+
+    /// @brief output of a channel for a window, calculated input by input.
+    template< typename C >
+    float reference(const typename C::Layer& layer, const std::vector< float >& in, std::size_t window, std::size_t channel) {
+        float sum = layer.biases()[channel];
+        for(std::size_t c = 0; c < C::inputChannels; ++c) {
+            for(std::size_t i = 0; i < C::Grid::size; ++i) {
+                if(C::Grid::contains(i, window)) {
+                    sum += layer.kernels()[C::weight(channel, c, C::Grid::localize(i, window))] * in[C::input(c, i)];
+                }
+            }
+        }
+        return std::tanh(sum);
+    }
+
+    TEMPLATE_TEST_CASE("Shared convolution layer uses one kernel per channel for all windows",
+                       "[layer][convolution][shared]",
+                       (Config< Grid, 3, 1, nn::Layout::NHWC >),
+                       (Config< Grid, 3, 2, nn::Layout::NHWC >),
+                       (Config< Grid, 3, 2, nn::Layout::NCHW >),
+                       (Config< Grid, 1, 3, nn::Layout::NCHW >),
+                       (Config< Pointwise, 3, 2, nn::Layout::NHWC >),
+                       (Config< Pointwise, 2, 3, nn::Layout::NCHW >),
+                       (Config< Winograd, 3, 2, nn::Layout::NHWC >),
+                       (Config< Winograd, 2, 3, nn::Layout::NCHW >),
+                       (Config< Large, 3, 2, nn::Layout::NHWC >),
+                       (Config< Large, 2, 3, nn::Layout::NCHW >)) {
+        using Layer = typename TestType::Layer;
+        using Context = typename TestType::Context;
+
+        Layer layer;
+        Context ctx;
+        auto& in = std::get< 0 >(ctx);
+        for(std::size_t i = 0; i < in.size(); ++i) {
+            in[i] = std::sin(static_cast< float >(i));
+        }
+
+        SECTION("the weights don't depend on the size of the grid") {
+            REQUIRE(Layer::size() == TestType::Grid::framesNumber * TestType::channels);
+            REQUIRE(Layer::weightsNumber() == TestType::Grid::K::size * TestType::inputChannels * TestType::channels);
+            REQUIRE(Layer::biasesNumber() == TestType::channels);
+        }
+
+        SECTION("every output is the kernel of its channel applied to its window") {
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            const std::vector< float > values(in.begin(), in.end());
+            const auto& out = std::get< 1 >(ctx);
+            for(std::size_t w = 0; w < TestType::Grid::framesNumber; ++w) {
+                for(std::size_t c = 0; c < TestType::channels; ++c) {
+                    REQUIRE_THAT(out[TestType::output(c, w)],
+                                 Catch::Matchers::WithinAbs(reference< TestType >(layer, values, w, c), 1e-5f));
+                }
+            }
+        }
+
+        SECTION("the outputs follow the changes of the kernels") {
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            for(std::size_t i = 0; i < layer.kernels().size(); i += 3) {
+                layer.kernels()[i] += 0.25f;
+            }
+            layer.template calculateOutputs< Context, 1, 0 >(ctx);
+            const std::vector< float > values(in.begin(), in.end());
+            for(std::size_t w = 0; w < TestType::Grid::framesNumber; ++w) {
+                for(std::size_t c = 0; c < TestType::channels; ++c) {
+                    REQUIRE_THAT(std::get< 1 >(ctx)[TestType::output(c, w)],
+                                 Catch::Matchers::WithinAbs(reference< TestType >(layer, values, w, c), 1e-5f));
+                }
+            }
+        }
+
+        SECTION("every sample of a batch gives the same outputs as alone") {
+            constexpr std::size_t batchSize = 4;
+            std::tuple< std::vector< float >, std::vector< float > > batchCtx;
+            auto& batchIn = std::get< 0 >(batchCtx);
+            std::get< 1 >(batchCtx).resize(batchSize * Layer::size());
+            for(std::size_t i = 0; i < batchSize * in.size(); ++i) {
+                batchIn.push_back(std::cos(static_cast< float >(i)));
+            }
+            layer.template calculateBatchOutputs< decltype(batchCtx), 1, 0 >(batchCtx, batchSize);
+
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                std::copy_n(batchIn.begin() + sample * in.size(), in.size(), in.begin());
+                layer.template calculateOutputs< Context, 1, 0 >(ctx);
+                for(std::size_t i = 0; i < Layer::size(); ++i) {
+                    REQUIRE_THAT(std::get< 1 >(batchCtx)[sample * Layer::size() + i],
+                                 Catch::Matchers::WithinAbs(std::get< 1 >(ctx)[i], 1e-5f));
+                }
+            }
+        }
+
+        SECTION("a smaller predecessor gives zeros for the missing inputs") {
+            using Small = std::tuple< std::array< float, Layer::inputs() >, std::array< float, Layer::size() > >;
+            Small small;
+            std::copy_n(in.begin(), Layer::inputs(), std::get< 0 >(small).begin());
+            layer.template calculateOutputs< Small, 1, 0 >(small);
+
+            std::vector< float > padded(in.size(), 0.f);
+            std::copy_n(in.begin(), Layer::inputs(), padded.begin());
+            for(std::size_t w = 0; w < TestType::Grid::framesNumber; ++w) {
+                for(std::size_t c = 0; c < TestType::channels; ++c) {
+                    REQUIRE_THAT(std::get< 1 >(small)[TestType::output(c, w)],
+                                 Catch::Matchers::WithinAbs(reference< TestType >(layer, padded, w, c), 1e-5f));
+                }
+            }
+        }
+    }
+
+    TEST_CASE("FFT convolution samples the correlation at the windows of the stride", "[layer][convolution][fft]") {
+        using C = Config< nn::SlidingWindow< 11, 9, nn::Kernel< 5, 4, 2 > >, 2, 3, nn::Layout::NCHW >;
+        typename C::Layer layer;
+        typename C::Context ctx;
+        auto& in = std::get< 0 >(ctx);
+        for(std::size_t i = 0; i < in.size(); ++i) {
+            in[i] = std::sin(static_cast< float >(i));
+        }
+
+        nn::detail::FftConvolution< float, C::Grid, C::channels, C::inputChannels, nn::Layout::NCHW > fft;
+        fft.transformKernels(layer.kernels().data());
+        std::array< float, C::Layer::size() > sums;
+        fft.convolve(in.data(), in.size(), layer.biases().data(), sums.data());
+
+        layer.calculateOutputs< C::Context, 1, 0 >(ctx);
+        for(std::size_t i = 0; i < sums.size(); ++i) {
+            REQUIRE_THAT(std::tanh(sums[i]), Catch::Matchers::WithinAbs(std::get< 1 >(ctx)[i], 1e-5f));
+        }
+    }
+} // namespace
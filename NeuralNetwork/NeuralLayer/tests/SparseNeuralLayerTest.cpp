@@ -0,0 +1,86 @@
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    SCENARIO("SparseNeuralLayer compared to MatrixNeuralLayer", "[layer][sparse][forward]") {
+        GIVEN("A matrix layer with small weights and a sparse layer pruned from it") {
+            nn::MatrixNeuralLayer< nn::Neuron, nn::SigmoidFunction, 6, 10 > matrixLayer;
+            nn::SparseNeuralLayer< nn::Neuron, nn::SigmoidFunction, 6, 10 > sparseLayer;
+
+            auto& weights = matrixLayer.weights();
+            for(std::size_t i = 0; i < weights.size(); ++i) {
+                weights[i] = std::sin(static_cast< float >(i + 1));
+            }
+            sparseLayer.prune(weights.data(), matrixLayer.biases().data(), 0.8f);
+            for(auto& weight : weights) {
+                weight = std::abs(weight) > 0.8f ? weight : 0.f;
+            }
+
+            THEN("Only the weights above the threshold are kept") {
+                std::size_t kept = 0;
+                for(auto weight : weights) {
+                    kept += weight != 0.f;
+                }
+                REQUIRE(sparseLayer.nonZeros() == kept);
+                REQUIRE(kept < weights.size() / 2);
+                REQUIRE(sparseLayer.rowOffsets().back() == kept);
+                REQUIRE(sparseLayer.biases() == matrixLayer.biases());
+            }
+
+            THEN("The mask clears the weights which were pruned") {
+                std::array< float, 60 > dense;
+                dense.fill(1.f);
+                sparseLayer.mask(dense.data());
+                for(std::size_t i = 0; i < dense.size(); ++i) {
+                    REQUIRE(dense[i] == (weights[i] != 0.f ? 1.f : 0.f));
+                }
+            }
+
+            WHEN("Both layers calculate the outputs of the same predecessor") {
+                using Context = std::tuple< std::array< float, 10 >, std::array< float, 6 > >;
+                Context matrixCtx{{0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f, 0.7f, 0.8f, -0.9f, 1.f}, {}};
+                Context sparseCtx = matrixCtx;
+                matrixLayer.calculateOutputs< Context, 1, 0 >(matrixCtx);
+                sparseLayer.calculateOutputs< Context, 1, 0 >(sparseCtx);
+                THEN("The outputs of both layers are the same") {
+                    for(std::size_t i = 0; i < 6; ++i) {
+                        REQUIRE(std::get< 1 >(sparseCtx)[i] == Catch::Approx(std::get< 1 >(matrixCtx)[i]).epsilon(1e-6));
+                        REQUIRE(sparseLayer[i].getOutput() == std::get< 1 >(sparseCtx)[i]);
+                    }
+                }
+            }
+
+            WHEN("The predecessor has less outputs than the layer inputs") {
+                using Context = std::tuple< std::array< float, 4 >, std::array< float, 6 > >;
+                Context matrixCtx{{0.1f, -0.2f, 0.3f, 0.4f}, {}};
+                Context sparseCtx = matrixCtx;
+                matrixLayer.calculateOutputs< Context, 1, 0 >(matrixCtx);
+                sparseLayer.calculateOutputs< Context, 1, 0 >(sparseCtx);
+                THEN("The missing inputs are ignored") {
+                    for(std::size_t i = 0; i < 6; ++i) {
+                        REQUIRE(std::get< 1 >(sparseCtx)[i] == Catch::Approx(std::get< 1 >(matrixCtx)[i]).epsilon(1e-6));
+                    }
+                }
+            }
+
+            WHEN("The layer is copied") {
+                auto copy = sparseLayer;
+                copy[0].setBias(10.f);
+                THEN("The copy owns its own storage") {
+                    REQUIRE(copy.biases()[0] == 10.f);
+                    REQUIRE(sparseLayer[0].getBias() == matrixLayer.biases()[0]);
+                    REQUIRE(copy.values() == sparseLayer.values());
+                }
+            }
+        }
+    }
+} // namespace
@@ -2,6 +2,7 @@
 #include "NeuralNetwork/Neuron/Input.h"
 
 #include <cstdlib>
+#include <type_traits>
 
 namespace nn {
 
@@ -28,4 +29,51 @@ namespace nn {
       protected:
         ~INeuron() = default;
     };
+
+    namespace detail {
+        /// @brief implements INeuron for a neuron which is not polymorphic
+        /// by itself, so the neurons pay for the virtual table only when
+        /// they are accessed through the interface (e.g. in a layer made of
+        /// different neuron types).
+        template< typename NeuronType >
+        struct PolymorphicNeuron final
+         : NeuronType
+         , INeuron< typename NeuronType::Var > {
+            using Var = typename NeuronType::Var;
+            using Input = typename NeuronType::Input;
+
+            using NeuronType::calcDotProduct;
+            using NeuronType::operator[];
+
+            Input& operator[](std::size_t id) override {
+                return NeuronType::operator[](id);
+            }
+
+            const Input& operator[](std::size_t id) const override {
+                return NeuronType::operator[](id);
+            }
+
+            const Var& getOutput() const override {
+                return NeuronType::getOutput();
+            }
+
+            Var calcDotProduct() const override {
+                return NeuronType::calcDotProduct();
+            }
+
+            const Var& getBias() const override {
+                return NeuronType::getBias();
+            }
+
+            void setBias(Var weight) override {
+                NeuronType::setBias(weight);
+            }
+        };
+
+        template< typename NeuronType >
+        using polymorphic_neuron_t =
+         std::conditional_t< std::is_base_of_v< INeuron< typename NeuronType::Var >, NeuronType >,
+                             NeuronType,
+                             PolymorphicNeuron< NeuronType > >;
+    } // namespace detail
 } // namespace nn
@@ -1,12 +1,14 @@
 #pragma once
 
-#include "NeuralNetwork/Neuron/INeuron.h"
 #include "NeuralNetwork/Neuron/Input.h"
 
 #include <System/Time.h>
 
 #include <range/v3/all.hpp>
 
+#include <array>
+#include <cstddef>
+
 namespace nn {
     /**
      * Neuron class.
@@ -16,7 +18,7 @@ namespace nn {
      */
     namespace detail {
         template< typename OutputFunctionType, std::size_t inputsNumber >
-        struct Neuron : INeuron< typename OutputFunctionType::Var > {
+        struct Neuron {
             using OutputFunction = OutputFunctionType;
             using Var = typename OutputFunction::Var;
             using Input = nn::Input< Var >;
@@ -35,7 +37,6 @@ namespace nn {
             template< std::size_t inputs >
             using resize = Neuron< OutputFunctionType, inputs >;
 
-            virtual ~Neuron() = default;
             static_assert(inputsNumber > 0, "Invalid number of inputs");
 
             auto cbegin() const {
@@ -109,12 +110,25 @@ namespace nn {
                 m_bias = weight;
             }
 
+            /// @brief sets the output calculated by the layer for all its
+            /// neurons at once.
+            void setOutput(const Var& output) {
+                m_output = output;
+            }
+
             template< typename Iterator >
             const Var& calculateOutput(const Var& dotProduct, Iterator begin, Iterator end) {
                 m_output = m_activationFunction.calculate(dotProduct, begin, end);
                 return m_output;
             }
 
+            /// @brief the same output as calculateOutput, but not stored, with
+            /// the activation function of this neuron.
+            template< typename Iterator >
+            Var calculateOutput(const Var& dotProduct, Iterator begin, Iterator end) const {
+                return m_activationFunction.calculate(dotProduct, begin, end);
+            }
+
           private:
             /**
              * @brief Instance of output calculation equation.
@@ -141,11 +155,6 @@ namespace nn {
              * calculation equation.
              */
             Var m_output{};
-
-            /**
-             * @brief Needed in order to calculate the neurons output value.
-             */
-            Var m_sum{};
         };
     } // namespace detail
 
@@ -21,6 +21,17 @@ namespace nn {
         }
     };
 
+    /// @brief Max whose pooling layer slides a monotonic deque over the
+    /// rows and then over the columns of the grid, every output costs O(1)
+    /// whatever the size of the window.
+    template< typename T >
+    struct SlidingMax : Max< T > {};
+
+    /// @brief Avg whose pooling layer takes the window sums from a summed
+    /// area table, every output costs O(1) whatever the size of the window.
+    template< typename T >
+    struct SummedAreaAvg : Avg< T > {};
+
     namespace detail {
 
         template< typename VarType, typename PoolingAlgo, std::size_t inputsNumber >
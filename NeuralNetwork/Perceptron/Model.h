@@ -0,0 +1,150 @@
+#pragma once
+
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+
+#include <MPL/Algorithm.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <tuple>
+
+namespace nn {
+
+    /**
+     * Read-only weights of a trained perceptron. The model holds no
+     * activations, so one instance can be shared by any number of threads,
+     * each of them evaluating through its own InferenceSession. Every layer
+     * after the input one needs the const calculateOutputs, which the
+     * convolution and pooling layers don't provide.
+     */
+    template< typename PerceptronType >
+    class Model {
+      public:
+        using Var = typename PerceptronType::VarType;
+        using Layers = typename PerceptronType::Layers;
+        using Context = typename PerceptronType::Context;
+        using Input = typename PerceptronType::Input;
+
+        static constexpr auto size() {
+            return PerceptronType::size();
+        }
+
+        static constexpr auto inputs() {
+            return PerceptronType::inputs();
+        }
+
+        static constexpr auto outputs() {
+            return PerceptronType::outputs();
+        }
+
+        /// @brief the number of values the features of all inputs take.
+        static constexpr auto features() {
+            return PerceptronType::features();
+        }
+
+        /// @brief takes the weights stored in the layers of the perceptron.
+        explicit Model(const PerceptronType& perceptron)
+         : m_layers(perceptron.layers()) {
+        }
+
+        /// @brief takes the trained weights and biases of a back
+        /// propagation context (bp::BPContext), one row-major
+        /// (neurons x inputs) matrix per layer.
+        template< typename WeightsContext >
+            requires requires(const WeightsContext& ctx) {
+                std::get< 0 >(ctx.weights);
+                std::get< 0 >(ctx.biases);
+            }
+        explicit Model(const WeightsContext& ctx) {
+            utils::for_< size() - 1 >([this, &ctx](auto i) {
+                constexpr auto idx = i.value + 1;
+                load(std::get< idx >(m_layers), std::get< idx >(ctx.weights), std::get< idx >(ctx.biases));
+            });
+        }
+
+        const Layers& layers() const {
+            return m_layers;
+        }
+
+        /**
+         * Evaluates the outputs of the perceptron.
+         * @param ctx the activations of all layers, owned by the caller.
+         * @param features the features of all inputs stored one input after
+         * another, at least features() values.
+         * @param out at least outputs() values where the results will be stored.
+         * @throw std::invalid_argument if one of the spans is too short.
+         */
+        void evaluate(Context& ctx, std::span< const Var > features, std::span< Var > out) const {
+            detail::checkSpans(features.size(), Model::features(), out.size(), outputs());
+            std::get< 0 >(m_layers).template calculateOutputs< Context, 0 >(ctx, features);
+            utils::for_< size() - 1 >([this, &ctx](auto i) {
+                const auto& layer = std::get< i.value + 1 >(m_layers);
+                layer.template calculateOutputs< Context, i.value + 1, i.value >(ctx);
+            });
+
+            const auto& outputCtx = std::get< size() - 1 >(ctx);
+            std::copy(outputCtx.begin(), outputCtx.end(), out.begin());
+        }
+
+      private:
+        template< typename Layer, typename Weights, typename Biases >
+        static void load(Layer& layer, const Weights& weights, const Biases& biases) {
+            if constexpr(requires { layer.prune(weights.data(), biases.data(), Var{}); }) {
+                // the weights which were pruned during the training are zero
+                layer.prune(weights.data(), biases.data(), Var{});
+            } else {
+                for(std::size_t neuron = 0; neuron < Layer::size(); ++neuron) {
+                    for(std::size_t input = 0; input < Layer::inputs(); ++input) {
+                        layer[neuron].setWeight(input, weights[neuron * Layer::inputs() + input]);
+                    }
+                    layer[neuron].setBias(biases[neuron]);
+                }
+            }
+        }
+
+        Layers m_layers;
+    };
+
+    /**
+     * Activations of one evaluation of a shared Model. A session is cheap
+     * compared to the model and must be used by one thread at a time, the
+     * model has to outlive it.
+     */
+    template< typename PerceptronType >
+    class InferenceSession {
+      public:
+        using Var = typename PerceptronType::VarType;
+        using Input = typename PerceptronType::Input;
+
+        explicit InferenceSession(const Model< PerceptronType >& model)
+         : m_model(&model) {
+        }
+
+        void evaluate(std::span< const Var > features, std::span< Var > out) {
+            m_model->evaluate(m_context, features, out);
+        }
+
+        /// @brief evaluates the inputs in the format of Perceptron::evaluate.
+        template< typename Iterator, typename OutputIterator >
+        void evaluate(Iterator begin, Iterator end, OutputIterator out) {
+            auto feature = m_features.begin();
+            for(; begin != end; ++begin) {
+                feature = std::copy(begin->value.begin(), begin->value.end(), feature);
+            }
+            std::array< Var, Model< PerceptronType >::outputs() > outputs;
+            m_model->evaluate(m_context, m_features, outputs);
+            std::copy(outputs.begin(), outputs.end(), out);
+        }
+
+        const typename Model< PerceptronType >::Context& context() const {
+            return m_context;
+        }
+
+      private:
+        const Model< PerceptronType >* m_model;
+        typename Model< PerceptronType >::Context m_context{};
+        std::array< Var, Model< PerceptronType >::features() > m_features{};
+    };
+} // namespace nn
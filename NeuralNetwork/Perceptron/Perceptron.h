@@ -1,11 +1,17 @@
 #pragma once
 
+#include "NeuralNetwork/Utils/Batch.h"
 #include "NeuralNetwork/Utils/Utils.h"
 
 #include <MPL/Tuple.h>
 #include <MPL/Algorithm.h>
 #include <MPL/TypeTraits.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
 #include <tuple>
 
 namespace nn {
@@ -22,6 +28,20 @@ namespace nn {
         constexpr auto wrap_layers(std::tuple< Layers... >)
          -> std::tuple< Wrapper< Layers >... >;
 
+        /// @brief rejects the spans of features and outputs shorter than
+        /// the perceptron reads and writes.
+        inline void checkSpans(std::size_t features,
+                               std::size_t requiredFeatures,
+                               std::size_t outputs,
+                               std::size_t requiredOutputs) {
+            if(features < requiredFeatures) {
+                throw std::invalid_argument("Invalid number of features");
+            }
+            if(outputs < requiredOutputs) {
+                throw std::invalid_argument("Invalid number of outputs");
+            }
+        }
+
         template< typename Var, typename... L >
         struct Perceptron {
             using VarType = Var;
@@ -40,6 +60,11 @@ namespace nn {
                 return InputLayerType::size();
             }
 
+            /// @brief the number of values the features of all inputs take.
+            static constexpr auto features() {
+                return inputs() * InputLayerType::inputs();
+            }
+
             using Layers = typename mpl::rebindInputs< TmplLayers >::type;
 
             using OutputLayerType =
@@ -58,10 +83,12 @@ namespace nn {
 
             using Input = typename InputLayerType::Input;
             using Context = std::tuple< std::array< Var, L::size() >... >;
+            using BatchContext = batch_context_t< Context >;
 
           private:
             Layers m_layers;
             Context m_context;
+            BatchContext m_batchContext;
 
             static_assert(std::tuple_size< Layers >::value > 1,
                           "Invalid number of layers, at least two layers need "
@@ -72,6 +99,10 @@ namespace nn {
                 return m_layers;
             }
 
+            const Layers& layers() const {
+                return m_layers;
+            }
+
             Context& context() {
                 return m_context;
             }
@@ -89,6 +120,95 @@ namespace nn {
              */
             template< typename Iterator, typename OutputIterator >
             void evaluate(Iterator begin, Iterator end, OutputIterator out) {
+                setInputs(begin, end);
+
+                auto& inputLayer0 = std::get< 0 >(m_layers);
+                inputLayer0.template calculateOutputs< decltype(m_context), 0 >(m_context);
+                propagate();
+
+                auto& outputCtx = std::get< size() - 1U >(m_context);
+                for(const auto& val : outputCtx) {
+                    *out = val;
+                    ++out;
+                }
+            }
+
+            /*!
+             * @brief evaluates the outputs of perceptron directly from the
+             * buffer of the caller. Neither the features nor the input
+             * neurons are copied or modified.
+             * @param features the features of all inputs stored one input
+             * after another, at least features() values.
+             * @param out at least outputs() values where the results of the
+             * evaluation will be stored.
+             * @throw std::invalid_argument if one of the spans is too short.
+             */
+            void evaluate(std::span< const Var > features, std::span< Var > out) {
+                detail::checkSpans(features.size(), Perceptron::features(), out.size(), outputs());
+
+                auto& inputLayer0 = std::get< 0 >(m_layers);
+                inputLayer0.template calculateOutputs< Context, 0 >(m_context, features);
+                propagate();
+
+                const auto& outputCtx = std::get< size() - 1U >(m_context);
+                std::copy(outputCtx.begin(), outputCtx.end(), out.begin());
+            }
+
+            /*!
+             * @brief evaluates the outputs of perceptron for a batch of
+             * samples. Every layer after the input one processes the whole
+             * batch at once, so the weights are loaded once per batch
+             * instead of once per sample.
+             * @param begin is the iterator which is pointing to the first
+             * input of the first sample, the samples follow one after
+             * another and each of them has inputs() inputs.
+             * @param batchSize the number of samples
+             * @param out the output iterator where outputs() results of every
+             * sample will be stored one sample after another.
+             */
+            template< typename Iterator, typename OutputIterator >
+            void evaluateBatch(Iterator begin, std::size_t batchSize, OutputIterator out) {
+                if(batchSize == 0) {
+                    return;
+                }
+
+                resize< Context >(m_batchContext, batchSize);
+
+                auto& inputLayer = std::get< 0 >(m_layers);
+                auto& inputRows = std::get< 0 >(m_batchContext);
+                const auto& inputOutputs = std::get< 0 >(m_context);
+                for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                    auto end = std::next(begin, inputs());
+                    setInputs(begin, end);
+                    begin = end;
+
+                    inputLayer.template calculateOutputs< Context, 0 >(m_context);
+                    std::copy(inputOutputs.begin(),
+                              inputOutputs.end(),
+                              inputRows.begin() + sample * inputOutputs.size());
+                }
+
+                utils::for_< size() - 1U >([this, batchSize](auto i) {
+                    auto& layer = utils::get< i.value + 1 >(m_layers);
+                    calculateBatchOutputs< i.value + 1, i.value >(
+                     layer, m_batchContext, m_context, batchSize);
+                });
+
+                const auto& outputRows = std::get< size() - 1U >(m_batchContext);
+                std::copy(outputRows.begin(), outputRows.end(), out);
+            }
+
+          private:
+            /// @brief calculates the outputs of all layers after the input one.
+            void propagate() {
+                utils::for_< size() - 1U >([this](auto i) {
+                    auto& layer = utils::get< i.value + 1 >(m_layers);
+                    layer.template calculateOutputs< Context, i.value + 1, i.value >(m_context);
+                });
+            }
+
+            template< typename Iterator >
+            void setInputs(Iterator begin, Iterator end) {
                 auto& inputLayer = std::get< 0 >(m_layers);
                 unsigned int inputId = 0;
                 while(begin != end) {
@@ -101,21 +221,6 @@ namespace nn {
                     begin++;
                     inputId++;
                 }
-
-                auto& inputLayer0 = std::get< 0 >(m_layers);
-                inputLayer0.template calculateOutputs< decltype(m_context), 0 >(m_context);
-
-                utils::for_< size() - 1U >([this](auto i) {
-                    auto& layer = utils::get< i.value + 1 >(m_layers);
-                    layer.template calculateOutputs< decltype(m_context), i.value + 1, i.value >(
-                     m_context);
-                });
-
-                auto& outputCtx = std::get< size() - 1U >(m_context);
-                for(const auto& val : outputCtx) {
-                    *out = val;
-                    ++out;
-                }
             }
         };
     } // namespace detail
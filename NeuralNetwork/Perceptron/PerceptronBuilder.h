@@ -5,6 +5,7 @@
 #include "NeuralNetwork/NeuralLayer/InputLayer.h"
 #include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
 #include "NeuralNetwork/NeuralLayer/PoolingLayer.h"
+#include "NeuralNetwork/NeuralLayer/SharedConvolutionLayer.h"
 #include "NeuralNetwork/NeuralLayer/Thread/AsyncNeuralLayer.h"
 #include "NeuralNetwork/Neuron/Neuron.h"
 #include "NeuralNetwork/Neuron/PoolingNeuron.h"
@@ -19,11 +20,23 @@
 
 namespace nn {
 
-    template< std::size_t W, std::size_t H, typename K >
+    /// @brief the convolution built by ConvBuilder. A convolution with
+    /// several channels shares its kernels between the windows.
+    template< std::size_t W,
+              std::size_t H,
+              typename K,
+              std::size_t In = 1,
+              std::size_t Out = 1,
+              Layout L = Layout::NHWC,
+              bool Shared = false >
     struct SlidingWindowConfig {
         static constexpr std::size_t width = W;
         static constexpr std::size_t height = H;
         using Kernel = K;
+        static constexpr std::size_t inputChannels = In;
+        static constexpr std::size_t outputChannels = Out;
+        static constexpr Layout layout = L;
+        static constexpr bool shared = Shared;
     };
 
     template< typename VarType, typename CurrentLayer, typename... PrevLayers >
@@ -33,24 +46,72 @@ namespace nn {
     struct ConvBuilder {
         template< std::size_t W, std::size_t H, std::size_t S >
         constexpr auto with_kernel() const {
-            using NewConfig =
-             SlidingWindowConfig< ConvConfig::width, ConvConfig::height, nn::Kernel< W, H, S > >;
-            return ConvBuilder< VarType, NewConfig, CurrentLayer, PrevLayers... >{};
+            return with< ConvConfig::width,
+                         ConvConfig::height,
+                         nn::Kernel< W, H, S >,
+                         ConvConfig::inputChannels,
+                         ConvConfig::outputChannels,
+                         ConvConfig::layout,
+                         ConvConfig::shared >();
         }
 
         template< std::size_t W, std::size_t H >
         constexpr auto with_grid() const {
-            using NewConfig = SlidingWindowConfig< W, H, typename ConvConfig::Kernel >;
-            return ConvBuilder< VarType, NewConfig, CurrentLayer, PrevLayers... >{};
+            return with< W,
+                         H,
+                         typename ConvConfig::Kernel,
+                         ConvConfig::inputChannels,
+                         ConvConfig::outputChannels,
+                         ConvConfig::layout,
+                         ConvConfig::shared >();
+        }
+
+        /// @brief the number of channels of the inputs and of the outputs,
+        /// the kernels are shared by all windows.
+        template< std::size_t In, std::size_t Out >
+        constexpr auto with_channels() const {
+            return with< ConvConfig::width,
+                         ConvConfig::height,
+                         typename ConvConfig::Kernel,
+                         In,
+                         Out,
+                         ConvConfig::layout,
+                         true >();
+        }
+
+        /// @brief the memory layout of the input and output channels, the
+        /// kernels are shared by all windows.
+        template< Layout L >
+        constexpr auto with_layout() const {
+            return with< ConvConfig::width,
+                         ConvConfig::height,
+                         typename ConvConfig::Kernel,
+                         ConvConfig::inputChannels,
+                         ConvConfig::outputChannels,
+                         L,
+                         true >();
         }
 
         constexpr auto build() const {
             using Grid =
              nn::SlidingWindow< ConvConfig::width, ConvConfig::height, typename ConvConfig::Kernel >;
-            using L =
-             ConvolutionLayer< nn::NeuralLayer, Neuron, SigmoidFunction, Grid, VarType >;
+            using L = std::conditional_t< ConvConfig::shared,
+                                          SharedConvolutionLayer< SigmoidFunction,
+                                                                  Grid,
+                                                                  ConvConfig::outputChannels,
+                                                                  ConvConfig::inputChannels,
+                                                                  ConvConfig::layout,
+                                                                  VarType >,
+                                          ConvolutionLayer< nn::NeuralLayer, Neuron, SigmoidFunction, Grid, VarType > >;
             return PerceptronBuilder< VarType, L, PrevLayers..., CurrentLayer >{};
         }
+
+      private:
+        template< std::size_t W, std::size_t H, typename K, std::size_t In, std::size_t Out, Layout L, bool Shared >
+        static constexpr auto with() {
+            using NewConfig = SlidingWindowConfig< W, H, K, In, Out, L, Shared >;
+            return ConvBuilder< VarType, NewConfig, CurrentLayer, PrevLayers... >{};
+        }
     };
 
     template< typename VarType, typename CurrentLayer, typename... PrevLayers >
@@ -80,9 +141,16 @@ namespace nn {
             return ConvBuilder< VarType, DefaultConfig, CurrentLayer, PrevLayers... >{};
         }
 
+        /// @brief convolution with channels kernels shared by all windows.
+        template< typename SlidingWindow, std::size_t channels = 1, std::size_t inputChannels = 1, Layout layout = Layout::NHWC >
+        constexpr auto shared_conv() const {
+            using L = SharedConvolutionLayer< SigmoidFunction, SlidingWindow, channels, inputChannels, layout, VarType >;
+            return PerceptronBuilder< VarType, L, PrevLayers..., CurrentLayer >{};
+        }
+
         template< template< class > class PoolingAlgo, typename SlidingWindow >
         constexpr auto pool() const {
-            using L = PoolingLayer< nn::NeuralLayer, PoolingAlgo, SlidingWindow, VarType >;
+            using L = PoolingLayer< PoolingAlgo, SlidingWindow, VarType >;
             return PerceptronBuilder< VarType, L, PrevLayers..., CurrentLayer >{};
         }
 
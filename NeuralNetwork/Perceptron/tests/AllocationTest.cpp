@@ -0,0 +1,64 @@
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    std::size_t allocations = 0;
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 4 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 16 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SigmoidFunction, 2 > >;
+
+    using Input = Perceptron::Input;
+
+    SCENARIO("Perceptron does not allocate", "[perceptron][allocation]") {
+        GIVEN("inputs for a perceptron with vector and matrix layers") {
+            const std::array< Input, 4 > inputs{
+             Input{{0.1f}}, Input{{0.2f}}, Input{{0.3f}}, Input{{0.4f}}};
+            std::array< float, Perceptron::outputs() > outputs{};
+
+            WHEN("a perceptron is constructed and evaluated") {
+                const auto before = allocations;
+                Perceptron perceptron;
+                perceptron.evaluate(inputs.begin(), inputs.end(), outputs.begin());
+                const auto after = allocations;
+
+                THEN("no memory is allocated on the heap") {
+                    REQUIRE(after == before);
+                }
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,99 @@
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/PoolingLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using SlidingWindow = nn::SlidingWindow< 4, 4, nn::Kernel< 3, 3, 1 > >;
+
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 16 >,
+                     nn::ConvolutionLayer< nn::NeuralLayer, nn::Neuron, nn::TanhFunction, SlidingWindow >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 12 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 3 > >;
+
+    using Input = Perceptron::Input;
+
+    using PoolingPerceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 16 >,
+                     nn::PoolingLayer< nn::Max, nn::SlidingWindow< 4, 4, nn::Kernel< 2, 2, 2 > > >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 3 > >;
+
+    SCENARIO("Perceptron evaluates a batch of samples", "[perceptron][batch]") {
+        GIVEN("a perceptron with convolution, matrix and vector layers") {
+            Perceptron perceptron;
+            constexpr std::size_t batchSize = 5;
+
+            std::vector< Input > inputs;
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                for(std::size_t i = 0; i < Perceptron::inputs(); ++i) {
+                    inputs.push_back(Input{{static_cast< float >((sample + 1) * (i % 5)) / 10.f}});
+                }
+            }
+
+            WHEN("evaluateBatch is called") {
+                std::vector< float > batchOutputs(batchSize * Perceptron::outputs());
+                perceptron.evaluateBatch(inputs.begin(), batchSize, batchOutputs.begin());
+
+                THEN("the outputs are the same as for the evaluation sample by sample") {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        std::array< float, Perceptron::outputs() > outputs;
+                        auto begin = inputs.begin() + sample * Perceptron::inputs();
+                        perceptron.evaluate(begin, begin + Perceptron::inputs(), outputs.begin());
+
+                        for(std::size_t i = 0; i < outputs.size(); ++i) {
+                            REQUIRE(batchOutputs[sample * Perceptron::outputs() + i] ==
+                                    Catch::Approx(outputs[i]).epsilon(1e-5));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    SCENARIO("Perceptron with a pooling layer evaluates a batch of samples", "[perceptron][batch][pooling]") {
+        GIVEN("a perceptron with max pooling") {
+            PoolingPerceptron perceptron;
+            constexpr std::size_t batchSize = 3;
+
+            std::vector< Input > inputs;
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                for(std::size_t i = 0; i < PoolingPerceptron::inputs(); ++i) {
+                    inputs.push_back(Input{{static_cast< float >((sample + 2) * (i % 7)) / 10.f}});
+                }
+            }
+
+            WHEN("evaluateBatch is called") {
+                std::vector< float > batchOutputs(batchSize * PoolingPerceptron::outputs());
+                perceptron.evaluateBatch(inputs.begin(), batchSize, batchOutputs.begin());
+
+                THEN("the outputs are the same as for the evaluation sample by sample") {
+                    for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                        std::array< float, PoolingPerceptron::outputs() > outputs;
+                        auto begin = inputs.begin() + sample * PoolingPerceptron::inputs();
+                        perceptron.evaluate(begin, begin + PoolingPerceptron::inputs(), outputs.begin());
+
+                        for(std::size_t i = 0; i < outputs.size(); ++i) {
+                            REQUIRE(batchOutputs[sample * PoolingPerceptron::outputs() + i] ==
+                                    Catch::Approx(outputs[i]).epsilon(1e-5));
+                        }
+                    }
+                }
+            }
+        }
+    }
+} // namespace
@@ -70,6 +70,16 @@ TEST_CASE("PerceptronBuilder pool avg", "[PerceptronBuilder]") {
      nn::build< float >().input< 64 >().template pool< nn::Avg, SlidingWindow >().size() == 2);
 }
 
+TEST_CASE("PerceptronBuilder pool with O(1) per output algorithms", "[PerceptronBuilder]") {
+    using SlidingWindow = nn::SlidingWindow< 8, 8, nn::Kernel< 4, 4, 1 > >;
+    using Perceptron = decltype(nn::build< float >()
+                                 .input< 64 >()
+                                 .template pool< nn::SlidingMax, SlidingWindow >()
+                                 .template pool< nn::SummedAreaAvg, SlidingWindow >())::type;
+    REQUIRE(std::is_same_v< std::tuple_element_t< 1, Perceptron::Layers >::Algorithm, nn::SlidingMax< float > >);
+    REQUIRE(std::is_same_v< std::tuple_element_t< 2, Perceptron::Layers >::Algorithm, nn::SummedAreaAvg< float > >);
+}
+
 TEST_CASE("PerceptronBuilder pool after conv", "[PerceptronBuilder]") {
     using SlidingWindow = nn::SlidingWindow< 8, 8, nn::Kernel< 3, 3, 1 > >;
     using SlidingWindow2 = nn::SlidingWindow< 6, 6, nn::Kernel< 2, 2, 2 > >;
@@ -88,3 +98,41 @@ TEST_CASE("PerceptronBuilder async", "[PerceptronBuilder]") {
              .template async< 10 >()
              .size() == 3);
 }
+
+TEST_CASE("PerceptronBuilder shared conv", "[PerceptronBuilder]") {
+    using SlidingWindow = nn::SlidingWindow< 8, 8, nn::Kernel< 3, 3, 1 > >;
+    using Perceptron = decltype(nn::build< float >()
+                                 .input< 64 >()
+                                 .shared_conv< SlidingWindow, 4 >()
+                                 .with_neuron< nn::Neuron< nn::TanhFunction, float > >()
+                                 .dense< 10 >())::type;
+    using Shared = std::tuple_element_t< 1, Perceptron::Layers >;
+    REQUIRE(Perceptron::size() == 3);
+    REQUIRE(Shared::size() == 64 * 4);
+    REQUIRE(Shared::weightsNumber() == 9 * 4);
+    REQUIRE(std::is_same_v< Shared::OutputFunction, nn::TanhFunction< float > >);
+}
+
+TEST_CASE("PerceptronBuilder conv with_channels and with_layout", "[PerceptronBuilder]") {
+    using Perceptron = decltype(nn::build< float >()
+                                 .input< 3 * 64 >()
+                                 .conv()
+                                 .with_grid< 8, 8 >()
+                                 .with_channels< 3, 16 >()
+                                 .with_layout< nn::Layout::NCHW >()
+                                 .build()
+                                 .conv()
+                                 .with_grid< 8, 8 >()
+                                 .with_kernel< 1, 1, 1 >()
+                                 .with_channels< 16, 4 >()
+                                 .with_layout< nn::Layout::NCHW >()
+                                 .build()
+                                 .dense< 10 >())::type;
+    using First = std::tuple_element_t< 1, Perceptron::Layers >;
+    using Pointwise = std::tuple_element_t< 2, Perceptron::Layers >;
+    REQUIRE(Perceptron::size() == 4);
+    REQUIRE(First::size() == 64 * 16);
+    REQUIRE(First::weightsNumber() == 9 * 3 * 16);
+    REQUIRE(Pointwise::inputs() == 16);
+    REQUIRE(Pointwise::weightsNumber() == 16 * 4);
+}
@@ -0,0 +1,75 @@
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/Math/FixedPoint.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <MPL/Algorithm.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Fixed = nn::math::FixedPoint<>;
+
+    template< typename Var >
+    using Perceptron =
+     nn::Perceptron< Var,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 6 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 12 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::SigmoidFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 3 > >;
+
+    SCENARIO("Perceptron evaluates with fixed point numbers", "[perceptron][fixed]") {
+        GIVEN("a float perceptron and a fixed point one with the same weights") {
+            Perceptron< float > reference;
+            Perceptron< Fixed > perceptron;
+            utils::for_< Perceptron< float >::size() >([&](auto i) {
+                auto& from = std::get< i.value >(reference.layers());
+                auto& to = std::get< i.value >(perceptron.layers());
+                using Layer = std::decay_t< decltype(from) >;
+                for(std::size_t neuron = 0; neuron < Layer::size(); ++neuron) {
+                    for(std::size_t input = 0; input < Layer::inputs(); ++input) {
+                        to[neuron].setWeight(input, Fixed(from[neuron].getWeight(input)));
+                    }
+                    to[neuron].setBias(Fixed(from[neuron].getBias()));
+                }
+            });
+
+            std::array< Perceptron< float >::Input, Perceptron< float >::inputs() > floatInputs;
+            std::array< Perceptron< Fixed >::Input, Perceptron< Fixed >::inputs() > fixedInputs;
+            for(std::size_t i = 0; i < floatInputs.size(); ++i) {
+                floatInputs[i].value[0] = std::sin(static_cast< float >(i)) * 2.f;
+                fixedInputs[i].value[0] = Fixed(floatInputs[i].value[0]);
+            }
+
+            WHEN("both are evaluated") {
+                std::array< float, Perceptron< float >::outputs() > expected;
+                std::array< Fixed, Perceptron< Fixed >::outputs() > actual;
+                reference.evaluate(floatInputs.begin(), floatInputs.end(), expected.begin());
+                perceptron.evaluate(fixedInputs.begin(), fixedInputs.end(), actual.begin());
+
+                THEN("the outputs are close to the float ones") {
+                    for(std::size_t i = 0; i < expected.size(); ++i) {
+                        REQUIRE(static_cast< float >(actual[i]) == Catch::Approx(expected[i]).margin(1e-3));
+                    }
+                }
+
+                THEN("the evaluation is repeatable bit by bit") {
+                    std::array< Fixed, Perceptron< Fixed >::outputs() > repeated;
+                    perceptron.evaluate(fixedInputs.begin(), fixedInputs.end(), repeated.begin());
+                    REQUIRE(repeated == actual);
+                }
+            }
+        }
+    }
+} // namespace
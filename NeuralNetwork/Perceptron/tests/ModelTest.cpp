@@ -0,0 +1,100 @@
+#include "NeuralNetwork/Perceptron/Model.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 16 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 12 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 4 > >;
+
+    using Features = std::array< float, Perceptron::inputs() >;
+    using Outputs = std::array< float, Perceptron::outputs() >;
+
+    Features features(std::size_t sample) {
+        Features result;
+        for(std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = std::sin(static_cast< float >(sample * result.size() + i));
+        }
+        return result;
+    }
+
+    SCENARIO("Model is shared by several inference sessions", "[perceptron][model]") {
+        GIVEN("a model built from a perceptron") {
+            Perceptron perceptron;
+            const nn::Model< Perceptron > model(perceptron);
+
+            constexpr std::size_t samples = 64;
+            std::vector< Outputs > expected(samples);
+            for(std::size_t sample = 0; sample < samples; ++sample) {
+                perceptron.evaluate(features(sample), expected[sample]);
+            }
+
+            WHEN("a session evaluates the inputs in the format of the perceptron") {
+                nn::InferenceSession< Perceptron > session(model);
+                std::array< Perceptron::Input, Perceptron::inputs() > inputs;
+                const auto values = features(3);
+                for(std::size_t i = 0; i < inputs.size(); ++i) {
+                    inputs[i].value[0] = values[i];
+                }
+                Outputs outputs;
+                session.evaluate(inputs.begin(), inputs.end(), outputs.begin());
+                THEN("the outputs are the same as the ones of the perceptron") {
+                    REQUIRE(outputs == expected[3]);
+                }
+            }
+
+            WHEN("a session gets fewer features than the model reads") {
+                nn::InferenceSession< Perceptron > session(model);
+                const auto values = features(0);
+                Outputs outputs;
+                THEN("the evaluation is rejected") {
+                    REQUIRE_THROWS_AS(session.evaluate(std::span(values).first(values.size() - 1), outputs),
+                                      std::invalid_argument);
+                }
+            }
+
+            WHEN("several threads evaluate the model at the same time") {
+                constexpr std::size_t threads = 4;
+                std::vector< Outputs > actual(samples);
+                std::vector< std::thread > workers;
+                for(std::size_t t = 0; t < threads; ++t) {
+                    workers.emplace_back([&model, &actual, t] {
+                        nn::InferenceSession< Perceptron > session(model);
+                        for(int repeat = 0; repeat < 50; ++repeat) {
+                            for(std::size_t sample = t; sample < samples; sample += threads) {
+                                session.evaluate(features(sample), actual[sample]);
+                            }
+                        }
+                    });
+                }
+                for(auto& worker : workers) {
+                    worker.join();
+                }
+
+                THEN("every thread gets the outputs of the perceptron") {
+                    for(std::size_t sample = 0; sample < samples; ++sample) {
+                        REQUIRE(actual[sample] == expected[sample]);
+                    }
+                }
+            }
+        }
+    }
+} // namespace
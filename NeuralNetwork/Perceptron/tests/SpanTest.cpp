@@ -0,0 +1,74 @@
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    template< std::size_t features >
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 9, features >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 12 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::SoftmaxFunction, 4 > >;
+
+    template< typename P >
+    void requireSameOutputs(P& perceptron, std::size_t features) {
+        std::vector< float > buffer(P::inputs() * features);
+        std::vector< typename P::Input > inputs(P::inputs());
+        for(std::size_t i = 0; i < buffer.size(); ++i) {
+            buffer[i] = std::sin(static_cast< float >(i)) * 0.5f;
+            inputs[i / features].value[i % features] = buffer[i];
+        }
+
+        std::array< float, P::outputs() > expected;
+        std::array< float, P::outputs() > actual;
+        perceptron.evaluate(inputs.begin(), inputs.end(), expected.begin());
+        perceptron.evaluate(buffer, actual);
+
+        for(std::size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(actual[i] == Catch::Approx(expected[i]).epsilon(1e-6));
+        }
+    }
+
+    SCENARIO("Perceptron evaluates from a span of features", "[perceptron][span]") {
+        GIVEN("a perceptron with one feature per input") {
+            Perceptron< 1 > perceptron;
+            THEN("the outputs are the same as for the evaluation from the inputs") {
+                requireSameOutputs(perceptron, 1);
+            }
+        }
+
+        GIVEN("a perceptron with three features per input") {
+            Perceptron< 3 > perceptron;
+            THEN("the outputs are the same as for the evaluation from the inputs") {
+                requireSameOutputs(perceptron, 3);
+            }
+        }
+
+        GIVEN("spans shorter than the features and the outputs of the perceptron") {
+            Perceptron< 3 > perceptron;
+            const std::vector< float > features(Perceptron< 3 >::features());
+            std::array< float, Perceptron< 3 >::outputs() > outputs;
+            THEN("the evaluation is rejected") {
+                REQUIRE_THROWS_AS(perceptron.evaluate(std::span(features).first(features.size() - 1), outputs),
+                                  std::invalid_argument);
+                REQUIRE_THROWS_AS(perceptron.evaluate(features, std::span(outputs).first(outputs.size() - 1)),
+                                  std::invalid_argument);
+                REQUIRE_NOTHROW(perceptron.evaluate(features, outputs));
+            }
+        }
+    }
+} // namespace
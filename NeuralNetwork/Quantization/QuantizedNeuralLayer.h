@@ -0,0 +1,173 @@
+#pragma once
+
+#include "NeuralNetwork/Math/Quantize.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+
+#include <cereal/cereal.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace nn::quant {
+
+    /// @brief how many scales are used for the weights of a layer.
+    enum class Granularity {
+        PerLayer,
+        PerNeuron
+    };
+
+    /**
+     * Fully connected layer with int8 weights. The inputs are quantized
+     * with a scale calibrated on a sample set, the dot products are
+     * accumulated in int32 together with the int32 biases and converted
+     * back to Var before the activation function is applied.
+     */
+    template< typename VarType, std::size_t neurons, std::size_t inputsNumber, typename OutputFunction >
+    struct QuantizedNeuralLayer {
+        using Var = VarType;
+
+        static constexpr auto size() {
+            return neurons;
+        }
+
+        static constexpr auto inputs() {
+            return inputsNumber;
+        }
+
+        /**
+         * Quantizes the weights and biases of a trained layer.
+         * @param weights row-major (neurons x inputs) matrix, the layout used by bp::BPContext.
+         * @param biases one bias per neuron.
+         * @param inputRange the largest absolute value of the inputs of the layer.
+         */
+        void quantize(const Var* weights, const Var* biases, Var inputRange, Granularity granularity) {
+            m_inputScale = scale(inputRange);
+
+            Var layerRange{};
+            std::array< Var, size() > ranges{};
+            for(std::size_t neuron = 0; neuron < size(); ++neuron) {
+                for(std::size_t input = 0; input < inputs(); ++input) {
+                    ranges[neuron] =
+                     std::max(ranges[neuron], std::abs(weights[neuron * inputs() + input]));
+                }
+                layerRange = std::max(layerRange, ranges[neuron]);
+            }
+
+            for(std::size_t neuron = 0; neuron < size(); ++neuron) {
+                const auto weightScale =
+                 scale(granularity == Granularity::PerLayer ? layerRange : ranges[neuron]);
+                math::quantize(weights + neuron * inputs(),
+                               weightScale,
+                               m_weights.data() + neuron * inputs(),
+                               inputs());
+
+                m_scales[neuron] = m_inputScale * weightScale;
+                const auto bias = std::round(static_cast< double >(biases[neuron]) / m_scales[neuron]);
+                m_biases[neuron] = static_cast< std::int32_t >(
+                 std::clamp(bias,
+                            static_cast< double >(std::numeric_limits< std::int32_t >::min()),
+                            static_cast< double >(std::numeric_limits< std::int32_t >::max())));
+            }
+        }
+
+        template< typename Context, std::size_t myIdx, std::size_t predecessorIdx >
+        void calculateOutputs(Context& ctx) {
+            const auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+            auto& myOutputs = std::get< myIdx >(ctx);
+            const auto inputSize = std::min(predecessorOutputs.size(), inputs());
+
+            math::quantize(predecessorOutputs.data(), m_inputScale, m_inputs.data(), inputSize);
+
+            std::array< std::int32_t, size() > sums = m_biases;
+            math::gemv(size(), inputSize, m_weights.data(), inputs(), m_inputs.data(), sums.data());
+
+            std::array< Var, size() > dotProducts;
+            for(std::size_t neuron = 0; neuron < size(); ++neuron) {
+                dotProducts[neuron] = static_cast< Var >(sums[neuron]) * m_scales[neuron];
+            }
+
+            if constexpr(requires(std::span< Var > values) {
+                             m_activationFunction.apply(std::span< const Var >(values), values);
+                         }) {
+                m_activationFunction.apply(dotProducts, std::span< Var >(myOutputs.data(), size()));
+            } else {
+                for(std::size_t neuron = 0; neuron < size(); ++neuron) {
+                    myOutputs[neuron] = m_activationFunction.calculate(
+                     dotProducts[neuron], dotProducts.cbegin(), dotProducts.cend());
+                }
+            }
+        }
+
+        const std::array< std::int8_t, neurons * inputsNumber >& weights() const {
+            return m_weights;
+        }
+
+        template< typename Archive >
+        void serialize(Archive& ar) {
+            ar(cereal::make_nvp("weights", m_weights));
+            ar(cereal::make_nvp("scales", m_scales));
+            ar(cereal::make_nvp("biases", m_biases));
+            ar(cereal::make_nvp("inputScale", m_inputScale));
+        }
+
+      private:
+        /// @brief maps [-range, range] onto [-127, 127], an empty range keeps
+        /// the values as they are.
+        static Var scale(Var range) {
+            return range > Var{} ? range / Var{127} : Var{1};
+        }
+
+        std::array< std::int8_t, neurons * inputsNumber > m_weights{};
+        /// @brief input scale * weight scale of every neuron.
+        std::array< Var, neurons > m_scales{};
+        std::array< std::int32_t, neurons > m_biases{};
+        Var m_inputScale{1};
+        std::array< std::int8_t, inputsNumber > m_inputs{};
+        OutputFunction m_activationFunction{};
+    };
+
+    namespace detail {
+        /// @brief true for the layers which multiply every input by a
+        /// weight of every neuron, the only ones QuantizedNeuralLayer can
+        /// replace.
+        template< typename Layer >
+        struct is_dense_layer : std::false_type {};
+
+        template< typename T, std::size_t sz >
+        struct is_dense_layer< nn::detail::NeuralLayer< nn::detail::Vector< T, sz > > > : std::true_type {};
+
+        template< typename T, std::size_t sz, typename Storage >
+        struct is_dense_layer< nn::detail::NeuralLayer< nn::detail::Matrix< T, sz, Storage > > > : std::true_type {};
+
+        /// @brief the pruned weights are zero in the weights of the back
+        /// propagation context the quantization reads.
+        template< typename T, std::size_t sz >
+        struct is_dense_layer< nn::detail::NeuralLayer< nn::detail::Sparse< T, sz > > > : std::true_type {};
+
+        template< typename Layer >
+        constexpr bool is_dense_layer_v = is_dense_layer< Layer >::value;
+
+        template< typename Layer >
+        struct quantized_layer {
+            static_assert(is_dense_layer_v< Layer >,
+                          "only fully connected layers (NeuralLayer, MatrixNeuralLayer, SparseNeuralLayer) "
+                          "can be quantized, convolution, pooling and complex layers can't");
+
+            using type = QuantizedNeuralLayer< typename Layer::Var,
+                                               Layer::size(),
+                                               Layer::inputs(),
+                                               std::tuple_element_t< 0, typename Layer::ActivationFunctions > >;
+        };
+    } // namespace detail
+
+    /// @brief quantized counterpart of a fully connected float layer.
+    template< typename Layer >
+    using quantized_layer_t = typename detail::quantized_layer< Layer >::type;
+} // namespace nn::quant
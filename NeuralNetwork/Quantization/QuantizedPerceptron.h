@@ -0,0 +1,150 @@
+#pragma once
+
+#include "NeuralNetwork/Quantization/QuantizedNeuralLayer.h"
+
+#include <MPL/Algorithm.h>
+
+#include <cereal/cereal.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace nn::quant {
+
+    namespace detail {
+        template< typename Layers, std::size_t... idx >
+        constexpr auto quantize_layers(std::index_sequence< idx... >)
+         -> std::tuple< quantized_layer_t< std::tuple_element_t< idx + 1, Layers > >... >;
+    } // namespace detail
+
+    /**
+     * Inference only copy of a trained perceptron. The input layer is kept
+     * as it is, all the other layers are replaced by QuantizedNeuralLayer.
+     * Only fully connected layers (NeuralLayer, MatrixNeuralLayer,
+     * SparseNeuralLayer) can be quantized, other layers fail to compile.
+     */
+    template< typename PerceptronType >
+    class QuantizedPerceptron {
+        using Var = typename PerceptronType::VarType;
+        using InputLayerType = std::tuple_element_t< 0, typename PerceptronType::Layers >;
+
+      public:
+        using VarType = Var;
+        using Input = typename PerceptronType::Input;
+        using Context = typename PerceptronType::Context;
+        using Layers = decltype(detail::quantize_layers< typename PerceptronType::Layers >(
+         std::make_index_sequence< PerceptronType::size() - 1 >()));
+
+        static constexpr auto size() {
+            return PerceptronType::size();
+        }
+
+        static constexpr auto inputs() {
+            return PerceptronType::inputs();
+        }
+
+        static constexpr auto outputs() {
+            return PerceptronType::outputs();
+        }
+
+        Layers& layers() {
+            return m_layers;
+        }
+
+        /**
+         * Quantizes the weights kept in the back propagation context of a
+         * trained algorithm. The samples are evaluated by the algorithm to
+         * find the range of the inputs of every layer.
+         * @param algorithm bp::BepAlgorithm the perceptron was trained with.
+         * @param begin, end prototypes (inputs, expected outputs) used for
+         * the calibration, usually a part of the training set.
+         */
+        template< typename Algorithm, typename Iterator >
+        void calibrate(Algorithm& algorithm,
+                       Iterator begin,
+                       Iterator end,
+                       Granularity granularity = Granularity::PerNeuron) {
+            std::array< Var, size() - 1 > ranges{};
+            std::array< Var, outputs() > outputs;
+            for(; begin != end; ++begin) {
+                const auto& sample = std::get< 0 >(*begin);
+                algorithm.evaluate(sample.begin(), sample.end(), outputs.begin());
+
+                utils::for_< size() - 1 >([&](auto i) {
+                    for(const auto& value : std::get< i.value >(algorithm.context().outputs)) {
+                        ranges[i.value] = std::max(ranges[i.value], std::abs(value));
+                    }
+                });
+            }
+
+            const auto& ctx = algorithm.context();
+            utils::for_< size() - 1 >([&](auto i) {
+                constexpr auto idx = i.value + 1;
+                std::get< i.value >(m_layers).quantize(std::get< idx >(ctx.weights).data(),
+                                                       std::get< idx >(ctx.biases).data(),
+                                                       ranges[i.value],
+                                                       granularity);
+            });
+        }
+
+        /*!
+         * @brief evaluates the outputs, see Perceptron::evaluate.
+         */
+        template< typename Iterator, typename OutputIterator >
+        void evaluate(Iterator begin, Iterator end, OutputIterator out) {
+            setInputs(begin, end);
+
+            m_inputLayer.template calculateOutputs< Context, 0 >(m_context);
+            utils::for_< size() - 1 >([this](auto i) {
+                std::get< i.value >(m_layers)
+                 .template calculateOutputs< Context, i.value + 1, i.value >(m_context);
+            });
+
+            for(const auto& val : std::get< size() - 1 >(m_context)) {
+                *out = val;
+                ++out;
+            }
+        }
+
+        template< typename Archive >
+        void serialize(Archive& ar) {
+            ar(cereal::make_nvp("layers", m_layers));
+        }
+
+      private:
+        template< typename Iterator >
+        void setInputs(Iterator begin, Iterator end) {
+            unsigned int inputId = 0;
+            while(begin != end) {
+                for(std::size_t featureIdx = 0; featureIdx < begin->value.size();
+                    ++featureIdx) {
+                    m_inputLayer[inputId][featureIdx].weight = 1.f;
+                    m_inputLayer[inputId].setBias({});
+                    m_inputLayer[inputId][featureIdx].value = begin->value[featureIdx];
+                }
+                begin++;
+                inputId++;
+            }
+        }
+
+        InputLayerType m_inputLayer;
+        Layers m_layers;
+        Context m_context;
+    };
+
+    /// @brief converts the perceptron trained by the algorithm into its
+    /// quantized version, see QuantizedPerceptron::calibrate.
+    template< typename PerceptronType, typename Algorithm, typename Iterator >
+    QuantizedPerceptron< PerceptronType > quantize(Algorithm& algorithm,
+                                                   Iterator begin,
+                                                   Iterator end,
+                                                   Granularity granularity = Granularity::PerNeuron) {
+        QuantizedPerceptron< PerceptronType > perceptron;
+        perceptron.calibrate(algorithm, begin, end, granularity);
+        return perceptron;
+    }
+} // namespace nn::quant
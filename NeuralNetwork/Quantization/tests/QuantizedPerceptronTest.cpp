@@ -0,0 +1,107 @@
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/BackPropagation/BepAlgorithm.h"
+#include "NeuralNetwork/NeuralLayer/ConvolutionLayer.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/NeuralLayer/PoolingLayer.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+#include "NeuralNetwork/Neuron/PoolingNeuron.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/Quantization/QuantizedPerceptron.h"
+
+#include <MPL/Algorithm.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 8 >,
+                     nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 32 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 16 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 4 > >;
+
+    using Algorithm = nn::bp::BepAlgorithm< Perceptron >;
+    using Prototype = Algorithm::Prototype;
+
+    float pseudoRandom(std::size_t i) {
+        return std::sin(static_cast< float >(i) * 12.9898f) * 0.5f;
+    }
+
+    std::vector< Prototype > prototypes(std::size_t count) {
+        std::vector< Prototype > result(count);
+        for(std::size_t sample = 0; sample < count; ++sample) {
+            for(std::size_t i = 0; i < Perceptron::inputs(); ++i) {
+                std::get< 0 >(result[sample])[i].value[0] =
+                 4.f * pseudoRandom(sample * Perceptron::inputs() + i);
+            }
+        }
+        return result;
+    }
+
+    SCENARIO("quantized perceptron follows the trained one", "[quantization]") {
+        GIVEN("a back propagation algorithm with the weights of different magnitudes") {
+            Algorithm algorithm(0.1f);
+            std::size_t seed = 1;
+            utils::for_< Perceptron::size() >([&](auto i) {
+                for(auto& weight : std::get< i.value >(algorithm.context().weights)) {
+                    weight = pseudoRandom(seed++) * static_cast< float >(i.value + 1);
+                }
+                for(auto& bias : std::get< i.value >(algorithm.context().biases)) {
+                    bias = pseudoRandom(seed++);
+                }
+            });
+
+            const auto calibrationSet = prototypes(64);
+            const auto testSet = prototypes(96);
+
+            const auto granularity =
+             GENERATE(nn::quant::Granularity::PerNeuron, nn::quant::Granularity::PerLayer);
+
+            WHEN("the perceptron is quantized") {
+                auto quantized = nn::quant::quantize< Perceptron >(
+                 algorithm, calibrationSet.begin(), calibrationSet.end(), granularity);
+
+                THEN("the outputs differ by the quantization error only") {
+                    for(const auto& prototype : testSet) {
+                        const auto& inputs = std::get< 0 >(prototype);
+                        std::array< float, Perceptron::outputs() > expected;
+                        std::array< float, Perceptron::outputs() > actual;
+                        algorithm.evaluate(inputs.begin(), inputs.end(), expected.begin());
+                        quantized.evaluate(inputs.begin(), inputs.end(), actual.begin());
+
+                        for(std::size_t i = 0; i < actual.size(); ++i) {
+                            REQUIRE(actual[i] == Catch::Approx(expected[i]).margin(0.03));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    SCENARIO("quantized layer keeps one byte per weight", "[quantization]") {
+        using Layer = std::tuple_element_t< 1, nn::quant::QuantizedPerceptron< Perceptron >::Layers >;
+        STATIC_REQUIRE(sizeof(Layer().weights()) == Layer::size() * Layer::inputs());
+        STATIC_REQUIRE(Layer::size() == 16);
+        STATIC_REQUIRE(Layer::inputs() == 32);
+    }
+
+    TEST_CASE("only fully connected layers are quantized", "[quantization]") {
+        using Grid = nn::SlidingWindow< 4, 4, nn::Kernel< 2, 2, 2 > >;
+        STATIC_REQUIRE(nn::quant::detail::is_dense_layer_v< nn::NeuralLayer< nn::Neuron, nn::TanhFunction, 4 > >);
+        STATIC_REQUIRE(nn::quant::detail::is_dense_layer_v< nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 4 > >);
+        STATIC_REQUIRE(nn::quant::detail::is_dense_layer_v< nn::SparseNeuralLayer< nn::Neuron, nn::TanhFunction, 4 > >);
+        STATIC_REQUIRE(!nn::quant::detail::is_dense_layer_v<
+                       nn::ConvolutionLayer< nn::NeuralLayer, nn::Neuron, nn::TanhFunction, Grid > >);
+        STATIC_REQUIRE(!nn::quant::detail::is_dense_layer_v< nn::PoolingLayer< nn::Max, Grid > >);
+    }
+} // namespace
@@ -1,3 +1,4 @@
 #pragma once
 
 #include "NeuralNetwork/BackPropagation/BPContext.h"
+#include "NeuralNetwork/Quantization/QuantizedPerceptron.h"
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace nn::serving {
+
+    /**
+     * Evaluates single samples submitted by many threads in batches. The
+     * requests are collected until maxBatchSize of them are waiting or the
+     * oldest one waited for maxWait, then one Perceptron::evaluateBatch
+     * calculates all of them and the futures of the requests are completed.
+     * The perceptron is used by the worker thread of the executor only.
+     */
+    template< typename PerceptronType >
+    class BatchingExecutor {
+      public:
+        using Var = typename PerceptronType::VarType;
+        using Input = typename PerceptronType::Input;
+        using Outputs = std::array< Var, PerceptronType::outputs() >;
+        using Clock = std::chrono::steady_clock;
+
+        BatchingExecutor(PerceptronType perceptron, std::size_t maxBatchSize, Clock::duration maxWait)
+         : m_perceptron(std::move(perceptron))
+         , m_maxBatchSize(std::max< std::size_t >(maxBatchSize, 1))
+         , m_maxWait(maxWait)
+         , m_worker([this] { run(); }) {
+        }
+
+        BatchingExecutor(const BatchingExecutor&) = delete;
+        BatchingExecutor& operator=(const BatchingExecutor&) = delete;
+
+        /// @brief the requests which are already submitted are calculated
+        /// before the executor is destroyed.
+        ~BatchingExecutor() {
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_one();
+            m_worker.join();
+        }
+
+        /**
+         * Queues one sample for the evaluation.
+         * @param features the features of all inputs stored one input after
+         * another, the format of Perceptron::evaluate.
+         * @return the outputs of the perceptron, available once the batch
+         * the sample belongs to is calculated.
+         */
+        std::future< Outputs > submit(std::span< const Var > features) {
+            Request request;
+            if(features.size() != request.inputs.size() * request.inputs[0].value.size()) {
+                throw std::invalid_argument("Invalid number of features");
+            }
+            auto feature = features.begin();
+            for(auto& input : request.inputs) {
+                std::copy_n(feature, input.value.size(), input.value.begin());
+                feature += input.value.size();
+            }
+            request.arrival = Clock::now();
+            auto result = request.result.get_future();
+
+            std::size_t waiting = 0;
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+                m_queue.push_back(std::move(request));
+                waiting = m_queue.size();
+            }
+            // the worker waits for the first request and for a full batch
+            if(waiting == 1 || waiting >= m_maxBatchSize) {
+                m_condition.notify_one();
+            }
+            return result;
+        }
+
+        /// @brief the number of batches calculated so far.
+        std::size_t batches() const {
+            return m_batches.load();
+        }
+
+      private:
+        struct Request {
+            std::array< Input, PerceptronType::inputs() > inputs;
+            std::promise< Outputs > result;
+            Clock::time_point arrival;
+        };
+
+        void run() {
+            std::vector< Request > batch;
+            std::vector< Input > inputs;
+            std::vector< Var > outputs;
+            while(true) {
+                {
+                    std::unique_lock< std::mutex > lock(m_mutex);
+                    m_condition.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                    if(m_queue.empty()) {
+                        return;
+                    }
+                    m_condition.wait_until(lock, m_queue.front().arrival + m_maxWait, [this] {
+                        return m_stop || m_queue.size() >= m_maxBatchSize;
+                    });
+
+                    const auto count = std::min(m_queue.size(), m_maxBatchSize);
+                    std::move(m_queue.begin(), m_queue.begin() + count, std::back_inserter(batch));
+                    m_queue.erase(m_queue.begin(), m_queue.begin() + count);
+                }
+
+                calculate(batch, inputs, outputs);
+                batch.clear();
+            }
+        }
+
+        void calculate(std::vector< Request >& batch, std::vector< Input >& inputs, std::vector< Var >& outputs) {
+            inputs.clear();
+            for(const auto& request : batch) {
+                inputs.insert(inputs.end(), request.inputs.begin(), request.inputs.end());
+            }
+            outputs.resize(batch.size() * PerceptronType::outputs());
+
+            try {
+                m_perceptron.evaluateBatch(inputs.begin(), batch.size(), outputs.begin());
+            } catch(...) {
+                for(auto& request : batch) {
+                    request.result.set_exception(std::current_exception());
+                }
+                return;
+            }
+
+            ++m_batches;
+            for(std::size_t sample = 0; sample < batch.size(); ++sample) {
+                Outputs result;
+                std::copy_n(outputs.begin() + sample * result.size(), result.size(), result.begin());
+                batch[sample].result.set_value(result);
+            }
+        }
+
+        PerceptronType m_perceptron;
+        const std::size_t m_maxBatchSize;
+        const Clock::duration m_maxWait;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque< Request > m_queue;
+        bool m_stop = false;
+        std::atomic< std::size_t > m_batches{0};
+
+        // started last, all the other members are initialized by then
+        std::thread m_worker;
+    };
+} // namespace nn::serving
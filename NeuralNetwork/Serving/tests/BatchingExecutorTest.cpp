@@ -0,0 +1,111 @@
+#include "NeuralNetwork/Serving/BatchingExecutor.h"
+#include "NeuralNetwork/Perceptron/Perceptron.h"
+#include "NeuralNetwork/NeuralLayer/InputLayer.h"
+#include "NeuralNetwork/NeuralLayer/NeuralLayer.h"
+#include "NeuralNetwork/ActivationFunction/SigmoidFunction.h"
+#include "NeuralNetwork/ActivationFunction/SoftmaxFunction.h"
+#include "NeuralNetwork/ActivationFunction/TanhFunction.h"
+#include "NeuralNetwork/Neuron/Neuron.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_NO_CPP17_UNCAUGHT_EXCEPTIONS
+#include <catch2/catch_all.hpp>
+
+namespace {
+    using Perceptron =
+     nn::Perceptron< float,
+                     nn::InputLayer< nn::Neuron, nn::SigmoidFunction, 6 >,
+                     nn::MatrixNeuralLayer< nn::Neuron, nn::TanhFunction, 10 >,
+                     nn::NeuralLayer< nn::Neuron, nn::SoftmaxFunction, 3 > >;
+
+    using Executor = nn::serving::BatchingExecutor< Perceptron >;
+    using Features = std::array< float, Perceptron::inputs() >;
+
+    Features features(std::size_t sample) {
+        Features result;
+        for(std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = std::cos(static_cast< float >(sample * result.size() + i));
+        }
+        return result;
+    }
+
+    SCENARIO("BatchingExecutor groups the requests of several threads", "[serving]") {
+        GIVEN("an executor which waits long enough to fill every batch") {
+            Perceptron perceptron;
+            Executor executor(perceptron, 8, std::chrono::seconds(10));
+
+            WHEN("four threads submit eight requests each") {
+                constexpr std::size_t threads = 4;
+                constexpr std::size_t perThread = 8;
+                std::vector< std::future< Executor::Outputs > > results(threads * perThread);
+                std::vector< std::thread > clients;
+                for(std::size_t t = 0; t < threads; ++t) {
+                    clients.emplace_back([&executor, &results, t] {
+                        for(std::size_t i = 0; i < perThread; ++i) {
+                            const auto sample = t * perThread + i;
+                            results[sample] = executor.submit(features(sample));
+                        }
+                    });
+                }
+                for(auto& client : clients) {
+                    client.join();
+                }
+
+                THEN("the requests are calculated in full batches") {
+                    for(std::size_t sample = 0; sample < results.size(); ++sample) {
+                        const auto outputs = results[sample].get();
+                        std::array< float, Perceptron::outputs() > expected;
+                        perceptron.evaluate(features(sample), expected);
+                        for(std::size_t i = 0; i < expected.size(); ++i) {
+                            REQUIRE(outputs[i] == Catch::Approx(expected[i]).epsilon(1e-5));
+                        }
+                    }
+                    REQUIRE(executor.batches() == threads * perThread / 8);
+                }
+            }
+
+            WHEN("the number of features is wrong") {
+                const std::array< float, 2 > wrong{};
+                THEN("the request is rejected") {
+                    REQUIRE_THROWS_AS(executor.submit(wrong), std::invalid_argument);
+                }
+            }
+        }
+
+        GIVEN("an executor with a short wait time") {
+            Executor executor(Perceptron{}, 8, std::chrono::milliseconds(1));
+
+            WHEN("a single request is submitted") {
+                auto result = executor.submit(features(0));
+                THEN("it is calculated without waiting for a full batch") {
+                    REQUIRE(result.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+                    REQUIRE(executor.batches() == 1);
+                }
+            }
+        }
+
+        GIVEN("an executor which would wait for a long time") {
+            std::optional< Executor > executor;
+            executor.emplace(Perceptron{}, 8, std::chrono::hours(1));
+
+            WHEN("the executor is destroyed with pending requests") {
+                auto first = executor->submit(features(0));
+                auto second = executor->submit(features(1));
+                executor.reset();
+                THEN("the pending requests are calculated") {
+                    REQUIRE(first.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                    REQUIRE(second.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                }
+            }
+        }
+    }
+} // namespace
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <MPL/Algorithm.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+namespace nn::detail {
+
+    /// @brief context used to evaluate a batch of samples. Keeps the
+    /// outputs of every layer for all samples in a row-major (sample x
+    /// neuron) buffer.
+    template< typename Context >
+    struct batch_context;
+
+    template< typename... Var, std::size_t... sizes >
+    struct batch_context< std::tuple< std::array< Var, sizes >... > > {
+        using type = std::tuple< std::vector< Var >... >;
+    };
+
+    template< typename Context >
+    using batch_context_t = typename batch_context< Context >::type;
+
+    template< typename Context >
+    void resize(batch_context_t< Context >& batchCtx, std::size_t batchSize) {
+        utils::for_< std::tuple_size_v< Context > >([&](auto i) {
+            constexpr auto layerSize =
+             std::tuple_size_v< std::tuple_element_t< i.value, Context > >;
+            std::get< i.value >(batchCtx).resize(layerSize * batchSize);
+        });
+    }
+
+    /// @brief calculates the outputs of a layer for a batch of samples.
+    /// Layers which provide calculateBatchOutputs process the whole batch
+    /// at once, all the others are evaluated sample by sample through the
+    /// single sample context.
+    template< std::size_t myIdx, std::size_t predecessorIdx, typename Layer, typename BatchContext, typename Context, typename... W >
+    void calculateBatchOutputs(Layer& layer,
+                               BatchContext& batchCtx,
+                               Context& ctx,
+                               std::size_t batchSize,
+                               const W&... wctx) {
+        if constexpr(requires {
+                         layer.template calculateBatchOutputs< BatchContext, myIdx, predecessorIdx >(
+                          batchCtx, batchSize, wctx...);
+                     }) {
+            layer.template calculateBatchOutputs< BatchContext, myIdx, predecessorIdx >(
+             batchCtx, batchSize, wctx...);
+        } else {
+            const auto& predecessorRows = std::get< predecessorIdx >(batchCtx);
+            auto& rows = std::get< myIdx >(batchCtx);
+            auto& predecessorOutputs = std::get< predecessorIdx >(ctx);
+            const auto& outputs = std::get< myIdx >(ctx);
+            for(std::size_t sample = 0; sample < batchSize; ++sample) {
+                std::copy_n(predecessorRows.begin() + sample * predecessorOutputs.size(),
+                            predecessorOutputs.size(),
+                            predecessorOutputs.begin());
+                layer.template calculateOutputs< Context, myIdx, predecessorIdx >(ctx, wctx...);
+                std::copy(outputs.begin(), outputs.end(), rows.begin() + sample * outputs.size());
+            }
+        }
+    }
+} // namespace nn::detail
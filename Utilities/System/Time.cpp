@@ -8,8 +8,9 @@ namespace utils {
 
         template< typename Var >
         Var rnd(unsigned int maxValue) {
-            std::random_device rd;
-            std::default_random_engine engine(rd());
+            // seeded once per thread, creating a random_device for every
+            // weight is slow and may allocate
+            thread_local std::default_random_engine engine(std::random_device{}());
             std::uniform_int_distribution< int > normalDist(0, maxValue - 1);
             return boost::numeric_cast< Var >(normalDist(engine));
         }
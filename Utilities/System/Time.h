@@ -1,6 +1,8 @@
 #pragma once
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <type_traits>
+
 namespace utils {
 
     namespace priv {
@@ -13,7 +15,10 @@ namespace utils {
 
     template< typename Var >
     Var createRandom(unsigned int maxValue) {
-        if(maxValue <= 1) {
+        if constexpr(!std::is_arithmetic_v< Var >) {
+            // number types like fixed point are converted from float
+            return Var(createRandom< float >(maxValue));
+        } else if(maxValue <= 1) {
             return priv::randomize< Var >(100u) / boost::numeric_cast< Var >(100.f);
         } else {
             return priv::randomize< Var >(maxValue);